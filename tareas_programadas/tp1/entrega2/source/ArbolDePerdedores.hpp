@@ -0,0 +1,201 @@
+// Copyright 2024 Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+#pragma once
+
+/**
+ * @class EntradaArreglo
+ * @brief Entrada de una mezcla de k vías que recorre una corrida ordenada que
+ * ya se encuentra en memoria.
+ */
+template <typename T>
+class EntradaArreglo {
+ public:
+  /**
+   * @brief Crea una entrada sobre el arreglo A[0:n-1].
+   *
+   * @param A Inicio de la corrida ordenada.
+   * @param n Cantidad de elementos de la corrida.
+   */
+  EntradaArreglo(const T* A, int n) : pos(A), fin(A + (n > 0 ? n : 0)) {}
+
+  /** Indica si ya se consumieron todos los elementos. */
+  bool agotada() const {
+    return pos == fin;
+  }
+
+  /** Devuelve el elemento actual de la corrida. */
+  const T& actual() const {
+    return *pos;
+  }
+
+  /** Avanza al siguiente elemento de la corrida. */
+  void avanzar() {
+    ++pos;
+  }
+
+ private:
+  const T* pos;  /** Elemento actual. */
+  const T* fin;  /** Posición siguiente al último elemento. */
+};
+
+/**
+ * @class EntradaConBuffer
+ * @brief Entrada de una mezcla de k vías que lee una corrida ordenada por
+ * bloques desde una fuente externa (archivo, socket, otro proceso).
+ *
+ * @details El lector recibe un buffer y su capacidad, y devuelve la cantidad
+ * de elementos que escribió; devolver 0 indica el final de la corrida. Solo
+ * se mantiene un bloque en memoria por entrada.
+ */
+template <typename T>
+class EntradaConBuffer {
+ public:
+  /** Función que llena el buffer y devuelve la cantidad de elementos leídos. */
+  using Lector = function<int(T*, int)>;
+
+  /**
+   * @brief Crea una entrada que se llena con el lector dado.
+   *
+   * @param lector Función que provee los siguientes elementos de la corrida.
+   * @param capacidad Cantidad de elementos que se leen en cada bloque.
+   */
+  explicit EntradaConBuffer(Lector lector, int capacidad = 4096)
+    : lector(std::move(lector)), buffer(capacidad > 0 ? capacidad : 1) {
+    rellenar();
+  }
+
+  /** Indica si ya se consumieron todos los elementos. */
+  bool agotada() const {
+    return llenos == 0;
+  }
+
+  /** Devuelve el elemento actual de la corrida. */
+  const T& actual() const {
+    return buffer[pos];
+  }
+
+  /** Avanza al siguiente elemento, leyendo otro bloque si es necesario. */
+  void avanzar() {
+    if (++pos == llenos) rellenar();
+  }
+
+ private:
+  Lector lector;  /** Fuente de los elementos. */
+  vector<T> buffer;  /** Bloque actual de la corrida. */
+  int pos = 0;  /** Posición del elemento actual dentro del bloque. */
+  int llenos = 0;  /** Cantidad de elementos válidos en el bloque. */
+
+  /** Lee el siguiente bloque de la corrida. */
+  void rellenar() {
+    pos = 0;
+    llenos = lector(buffer.data(), static_cast<int>(buffer.size()));
+    if (llenos < 0) llenos = 0;
+  }
+};
+
+/**
+ * @class ArbolDePerdedores
+ * @brief Árbol de torneo de perdedores para mezclar k corridas ordenadas.
+ *
+ * @details Cada nodo interno guarda el índice de la entrada que perdió el
+ * torneo en ese nodo y la raíz guarda al ganador. Al extraer el mínimo solo
+ * se repite el torneo en el camino de la hoja ganadora a la raíz, por lo que
+ * cada elemento cuesta alrededor de lg(k) comparaciones. Los empates se
+ * resuelven a favor de la entrada con menor índice, así que la mezcla es
+ * estable. El tipo Entrada debe proveer agotada(), actual() y avanzar(), como
+ * EntradaArreglo y EntradaConBuffer.
+ */
+template <typename T, typename Entrada>
+class ArbolDePerdedores {
+ public:
+  /**
+   * @brief Construye el árbol y juega el torneo inicial.
+   *
+   * @param entradas Corridas a mezclar; deben vivir mientras se use el árbol.
+   */
+  explicit ArbolDePerdedores(vector<Entrada>& entradas)
+    : entradas(entradas), k(static_cast<int>(entradas.size())),
+      perdedores(entradas.size() > 0 ? entradas.size() : 1) {
+    ganador = (k > 0) ? construir(1) : 0;
+  }
+
+  /** Indica si ya se mezclaron todos los elementos. */
+  bool vacio() const {
+    return k == 0 || entradas[ganador].agotada();
+  }
+
+  /** Devuelve el menor elemento pendiente. */
+  const T& minimo() const {
+    return entradas[ganador].actual();
+  }
+
+  /**
+   * @brief Consume el menor elemento y repite el torneo en su camino.
+   */
+  void avanzar() {
+    entradas[ganador].avanzar();
+    int g = ganador;
+    for (int nodo = (g + k) / 2; nodo >= 1; nodo /= 2) {
+      if (menor(perdedores[nodo], g)) swap(g, perdedores[nodo]);
+    }
+    ganador = g;
+  }
+
+  /**
+   * @brief Extrae hasta 'capacidad' elementos en orden.
+   *
+   * @param destino Buffer donde se escriben los elementos.
+   * @param capacidad Cantidad máxima de elementos a escribir.
+   * @return La cantidad de elementos escritos; 0 si ya no quedan.
+   */
+  int extraer(T* destino, int capacidad) {
+    int escritos = 0;
+    while (escritos < capacidad && !vacio()) {
+      destino[escritos++] = minimo();
+      avanzar();
+    }
+    return escritos;
+  }
+
+ private:
+  vector<Entrada>& entradas;  /** Corridas que se están mezclando. */
+  int k;  /** Cantidad de corridas (hojas del árbol). */
+  vector<int> perdedores;  /** Perdedor de cada nodo interno (1..k-1). */
+  int ganador = 0;  /** Entrada con el menor elemento actual. */
+
+  /**
+   * @brief Compara las entradas a y b; una entrada agotada es mayor que
+   * cualquier otra.
+   */
+  bool menor(int a, int b) const {
+    if (entradas[a].agotada()) return false;
+    if (entradas[b].agotada()) return true;
+    if (entradas[a].actual() < entradas[b].actual()) return true;
+    if (entradas[b].actual() < entradas[a].actual()) return false;
+    return a < b;
+  }
+
+  /**
+   * @brief Juega el torneo inicial en el subárbol con raíz en 'nodo'. Las
+   * hojas son los nodos k..2k-1.
+   *
+   * @return El índice de la entrada ganadora del subárbol.
+   */
+  int construir(int nodo) {
+    if (nodo >= k) return nodo - k;
+    int a = construir(2 * nodo);
+    int b = construir(2 * nodo + 1);
+    if (menor(a, b)) {
+      perdedores[nodo] = b;
+      return a;
+    }
+    perdedores[nodo] = a;
+    return b;
+  }
+};
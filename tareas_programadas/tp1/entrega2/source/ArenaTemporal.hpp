@@ -0,0 +1,148 @@
+// Copyright 2024 Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+using namespace std;
+
+#pragma once
+
+/**
+ * @class ArenaTemporal
+ * @brief Memoria temporal reutilizable para los algoritmos de ordenamiento.
+ *
+ * @details La arena reserva una sola región con mmap y solo la reemplaza
+ * cuando se pide más espacio del que tiene, de modo que ordenar muchas veces
+ * no vuelve a pasar por el asignador ni por fallos de página. Antes de cada
+ * ordenamiento se llama a preparar() con la cantidad total de bytes que se
+ * van a usar, y luego se toman los buffers con asignar(). Opcionalmente la
+ * región se respalda con páginas grandes: primero se intenta MAP_HUGETLB y,
+ * si el sistema no tiene páginas grandes reservadas, se usa una región normal
+ * con la sugerencia MADV_HUGEPAGE. Una arena no es segura para usarse desde
+ * varios hilos a la vez; cada hilo debe tener la suya.
+ */
+class ArenaTemporal {
+ public:
+  /**
+   * @brief Crea una arena vacía; no reserva memoria hasta que se necesite.
+   *
+   * @param paginasGrandes Indica si se deben usar páginas grandes.
+   */
+  explicit ArenaTemporal(bool paginasGrandes = false)
+    : paginasGrandes(paginasGrandes) {}
+
+  /** Libera la región de la arena. */
+  ~ArenaTemporal() {
+    liberar();
+  }
+
+  /** La región no se comparte, por lo que la arena no se puede copiar. */
+  ArenaTemporal(const ArenaTemporal&) = delete;
+  ArenaTemporal& operator=(const ArenaTemporal&) = delete;
+
+  /**
+   * @brief Asegura que la arena tenga al menos 'bytes' de capacidad y
+   * descarta los buffers asignados anteriormente.
+   *
+   * @param bytes Total de bytes que se van a asignar, contando el relleno de
+   * alineamiento de cada buffer (ver bytesPara()).
+   */
+  void preparar(size_t bytes) {
+    usados = 0;
+    if (bytes <= capacidad) return;
+    size_t anterior = capacidad;
+    liberar();
+    reservar(bytes, anterior);
+  }
+
+  /**
+   * @brief Toma un buffer de 'cantidad' elementos de la arena.
+   *
+   * @details El buffer queda alineado a una línea de caché y su contenido no
+   * se inicializa. Los buffers siguen siendo válidos hasta el próximo llamado
+   * a preparar().
+   * @param cantidad Cantidad de elementos del buffer.
+   * @return Puntero al buffer.
+   */
+  template <typename T>
+  T* asignar(size_t cantidad) {
+    size_t bytes = bytesPara<T>(cantidad);
+    if (usados + bytes > capacidad) throw bad_alloc();
+    T* buffer = reinterpret_cast<T*>(static_cast<char*>(region) + usados);
+    usados += bytes;
+    return buffer;
+  }
+
+  /**
+   * @brief Calcula los bytes que ocupa un buffer de 'cantidad' elementos,
+   * incluyendo el relleno de alineamiento.
+   */
+  template <typename T>
+  static size_t bytesPara(size_t cantidad) {
+    size_t bytes = cantidad * sizeof(T);
+    return (bytes + kLineaCache - 1) / kLineaCache * kLineaCache;
+  }
+
+  /** Devuelve la capacidad actual de la arena en bytes. */
+  size_t getCapacidad() const {
+    return capacidad;
+  }
+
+  /** Indica si la región actual está respaldada por MAP_HUGETLB. */
+  bool usaHugetlb() const {
+    return hugetlb;
+  }
+
+ private:
+  static constexpr size_t kLineaCache = 64;  /** Alineamiento de buffers. */
+  static constexpr size_t kPaginaGrande = size_t(2) << 20;  /** 2 MiB. */
+
+  bool paginasGrandes;  /** Si se deben intentar páginas grandes. */
+  void* region = nullptr;  /** Región reservada con mmap. */
+  size_t capacidad = 0;  /** Bytes de la región. */
+  size_t usados = 0;  /** Bytes asignados desde el último preparar(). */
+  bool hugetlb = false;  /** Si la región usa MAP_HUGETLB. */
+
+  /**
+   * @brief Reserva una región de al menos 'bytes'. Si ya había una región, la
+   * nueva tiene al menos el doble de tamaño para que una serie de tamaños
+   * crecientes no la reemplace cada vez.
+   */
+  void reservar(size_t bytes, size_t anterior) {
+    size_t tam = (bytes > 2 * anterior) ? bytes : 2 * anterior;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    if (paginasGrandes) {
+      tam = (tam + kPaginaGrande - 1) / kPaginaGrande * kPaginaGrande;
+#ifdef MAP_HUGETLB
+      region = mmap(nullptr, tam, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB,
+        -1, 0);
+      hugetlb = (region != MAP_FAILED);
+#else
+      region = MAP_FAILED;
+#endif
+    }
+    if (!hugetlb) {
+      region = mmap(nullptr, tam, PROT_READ | PROT_WRITE, flags, -1, 0);
+      if (region == MAP_FAILED) {
+        region = nullptr;
+        throw bad_alloc();
+      }
+#ifdef MADV_HUGEPAGE
+      if (paginasGrandes) madvise(region, tam, MADV_HUGEPAGE);
+#endif
+    }
+    capacidad = tam;
+  }
+
+  /** Devuelve la región al sistema operativo. */
+  void liberar() {
+    if (region != nullptr) munmap(region, capacidad);
+    region = nullptr;
+    capacidad = 0;
+    usados = 0;
+    hugetlb = false;
+  }
+};
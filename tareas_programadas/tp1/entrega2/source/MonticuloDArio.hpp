@@ -0,0 +1,262 @@
+// Copyright 2024 Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+#pragma once
+
+/** Devuelve el índice del padre de un nodo en un montículo d-ario. */
+template <int D>
+constexpr int padreDArio(int i) {
+  return (i - 1) / D;
+}
+
+/** Devuelve el índice del k-ésimo hijo (k en [0, D)) de un nodo. */
+template <int D>
+constexpr int hijoDArio(int i, int k) {
+  return D * i + 1 + k;
+}
+
+/**
+ * @class MonticuloDArio
+ * @brief Cola de prioridad indexada implementada como un montículo d-ario.
+ *
+ * @details Cada elemento se identifica con un índice en [0, capacidad) y
+ * tiene una llave; en el tope queda el elemento cuya llave va primero según
+ * el comparador (con less, la menor). El arreglo del montículo guarda la
+ * llave junto con el índice, de modo que las comparaciones no siguen
+ * punteros, y un mapa de posiciones permite cambiar la llave de un elemento
+ * en O(log_D n). Con D = 4 un nodo y sus hijos suelen caer en la misma línea
+ * de caché y el árbol es la mitad de alto que uno binario. Toda la memoria se
+ * reserva en el constructor, por lo que ninguna operación reserva memoria.
+ * @tparam T Tipo de las llaves.
+ * @tparam D Cantidad de hijos por nodo.
+ * @tparam Comparador Devuelve true si su primer argumento va antes.
+ */
+template <typename T, int D = 4, typename Comparador = less<T>>
+class MonticuloDArio {
+  static_assert(D >= 2, "Un montículo necesita al menos 2 hijos por nodo.");
+
+ public:
+  /**
+   * @brief Crea un montículo vacío para los índices [0, capacidad).
+   *
+   * @param capacidad Cantidad de índices distintos que se pueden insertar.
+   * @param comparador Comparador de llaves.
+   */
+  explicit MonticuloDArio(int capacidad, Comparador comparador = Comparador())
+    : posicion(capacidad > 0 ? capacidad : 0, -1),
+      comparador(comparador) {
+    monticulo.reserve(posicion.size());
+  }
+
+  /** Indica si el montículo está vacío. */
+  bool vacio() const {
+    return monticulo.empty();
+  }
+
+  /** Devuelve la cantidad de elementos en el montículo. */
+  int tamano() const {
+    return static_cast<int>(monticulo.size());
+  }
+
+  /** Indica si el índice está en el montículo. */
+  bool contiene(int id) const {
+    return id >= 0 && id < static_cast<int>(posicion.size()) &&
+      posicion[id] != -1;
+  }
+
+  /** Devuelve la llave de un índice que está en el montículo. */
+  const T& llave(int id) const {
+    return monticulo[posicion[id]].llave;
+  }
+
+  /** Devuelve el índice del tope, o -1 si el montículo está vacío. */
+  int tope() const {
+    return vacio() ? -1 : monticulo[0].id;
+  }
+
+  /** Devuelve la llave del tope; el montículo no debe estar vacío. */
+  const T& llaveTope() const {
+    return monticulo[0].llave;
+  }
+
+  /**
+   * @brief Inserta un índice con su llave.
+   *
+   * @param id Índice a insertar; se ignora si es inválido o ya está.
+   * @param llave Llave del índice.
+   */
+  void insertar(int id, const T& llave) {
+    /** Verificación defensiva de entrada. */
+    if (id < 0 || id >= static_cast<int>(posicion.size()) ||
+      posicion[id] != -1) {
+      return;
+    }
+    monticulo.push_back({llave, id});
+    subir(tamano() - 1);
+  }
+
+  /** Elimina el tope del montículo. */
+  void extraer() {
+    if (vacio()) return;
+    posicion[monticulo[0].id] = -1;
+    Nodo ultimo = monticulo.back();
+    monticulo.pop_back();
+    if (vacio()) return;
+    /**
+     * El último nodo casi siempre termina cerca de las hojas, así que primero
+     * se baja el hueco de la raíz hasta una hoja sin compararlo con él y
+     * luego se sube desde ahí, lo que ahorra una comparación por nivel.
+     */
+    int n = tamano();
+    int i = 0;
+    while (true) {
+      int primero = hijoDArio<D>(i, 0);
+      if (primero >= n) break;
+      int mejor = mejorHijo(primero, n);
+      monticulo[i] = monticulo[mejor];
+      posicion[monticulo[i].id] = i;
+      i = mejor;
+    }
+    monticulo[i] = ultimo;
+    subir(i);
+  }
+
+  /**
+   * @brief Elimina un índice cualquiera del montículo.
+   *
+   * @param id Índice a eliminar; se ignora si no está.
+   */
+  void eliminar(int id) {
+    if (!contiene(id)) return;
+    int i = posicion[id];
+    posicion[id] = -1;
+    Nodo ultimo = monticulo.back();
+    monticulo.pop_back();
+    if (i < tamano()) {
+      monticulo[i] = ultimo;
+      posicion[ultimo.id] = i;
+      subir(i);
+      bajar(posicion[ultimo.id]);
+    }
+  }
+
+  /**
+   * @brief Cambia la llave de un índice por una que va antes (con less, una
+   * menor) y lo sube hacia el tope.
+   *
+   * @param id Índice a modificar; se ignora si no está.
+   * @param llave Nueva llave; se ignora si no va antes que la actual.
+   */
+  void disminuirLlave(int id, const T& llave) {
+    if (!contiene(id)) return;
+    int i = posicion[id];
+    if (comparador(monticulo[i].llave, llave)) return;
+    monticulo[i].llave = llave;
+    subir(i);
+  }
+
+  /**
+   * @brief Cambia la llave de un índice por una que va después (con less, una
+   * mayor) y lo baja hacia las hojas.
+   *
+   * @param id Índice a modificar; se ignora si no está.
+   * @param llave Nueva llave; se ignora si va antes que la actual.
+   */
+  void aumentarLlave(int id, const T& llave) {
+    if (!contiene(id)) return;
+    int i = posicion[id];
+    if (comparador(llave, monticulo[i].llave)) return;
+    monticulo[i].llave = llave;
+    bajar(i);
+  }
+
+  /**
+   * @brief Reemplaza el contenido con los índices [0, n) y sus llaves,
+   * construyendo el montículo en O(n).
+   *
+   * @param llaves Llave de cada índice.
+   * @param n Cantidad de llaves; se limita a la capacidad.
+   */
+  void construir(const T* llaves, int n) {
+    for (int& p : posicion) p = -1;
+    monticulo.clear();
+    if (llaves == nullptr || n <= 0) return;
+    if (n > static_cast<int>(posicion.size())) {
+      n = static_cast<int>(posicion.size());
+    }
+    for (int i = 0; i < n; ++i) {
+      monticulo.push_back({llaves[i], i});
+      posicion[i] = i;
+    }
+    /** Bajar cada nodo interno, del último al primero. */
+    for (int i = padreDArio<D>(n - 1); i >= 0; --i) {
+      bajar(i);
+    }
+  }
+
+ private:
+  /** Entrada del montículo: la llave junto al índice que la posee. */
+  struct Nodo {
+    T llave;
+    int id;
+  };
+
+  vector<Nodo> monticulo;  /** Arreglo del montículo. */
+  vector<int> posicion;  /** Posición de cada índice, o -1 si no está. */
+  Comparador comparador;  /** Comparador de llaves. */
+
+  /**
+   * @brief Devuelve la posición del hijo que va primero entre los hermanos
+   * que empiezan en 'primero'.
+   */
+  int mejorHijo(int primero, int n) const {
+    int ultimo = (primero + D < n) ? primero + D : n;
+    int mejor = primero;
+    for (int c = primero + 1; c < ultimo; ++c) {
+      if (comparador(monticulo[c].llave, monticulo[mejor].llave)) mejor = c;
+    }
+    return mejor;
+  }
+
+  /**
+   * @brief Sube el nodo de la posición i mientras vaya antes que su padre.
+   * Se mueve un "hueco" en lugar de intercambiar en cada nivel.
+   */
+  void subir(int i) {
+    Nodo nodo = monticulo[i];
+    while (i > 0) {
+      int p = padreDArio<D>(i);
+      if (!comparador(nodo.llave, monticulo[p].llave)) break;
+      monticulo[i] = monticulo[p];
+      posicion[monticulo[i].id] = i;
+      i = p;
+    }
+    monticulo[i] = nodo;
+    posicion[nodo.id] = i;
+  }
+
+  /**
+   * @brief Baja el nodo de la posición i mientras alguno de sus hijos vaya
+   * antes que él.
+   */
+  void bajar(int i) {
+    int n = tamano();
+    Nodo nodo = monticulo[i];
+    while (true) {
+      int primero = hijoDArio<D>(i, 0);
+      if (primero >= n) break;
+      int mejor = mejorHijo(primero, n);
+      if (!comparador(monticulo[mejor].llave, nodo.llave)) break;
+      monticulo[i] = monticulo[mejor];
+      posicion[monticulo[i].id] = i;
+      i = mejor;
+    }
+    monticulo[i] = nodo;
+    posicion[nodo.id] = i;
+  }
+};
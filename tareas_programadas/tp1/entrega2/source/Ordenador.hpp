@@ -1,15 +1,28 @@
 // Copyright 2024 Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
 
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
 #include <limits.h>
+#include <memory>
 #include <random>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "ArbolDePerdedores.hpp"
+#include "ArenaTemporal.hpp"
+#include "MonticuloDArio.hpp"
+
 using namespace std;
 
 #pragma once
@@ -19,15 +32,39 @@ using namespace std;
  * @brief Clase que implementa varios algoritmos de ordenamiento.
  * 
  * @details Esta clase incluye los métodos para ordenar arreglos de valores
- * utilizando los Algoritmos de Ordenamiento por Selección, Inserción, Mezcla,
- * Montículos, Ordenamiento Rápido y por Residuos. Los métodos hacen uso de
- * programación defensiva y están basados en el pseudocódigo provisto en el
- * libro de Cormen y colaboradores. La implementación de cada algoritmo se
- * realiza dentro del cuerpo de la clase para garantizar una correcta
- * compilación y ejecución.
+ * utilizando los Algoritmos de Ordenamiento por Selección, Inserción, Mezcla
+ * (con memoria temporal o en sitio), Montículos, Ordenamiento Rápido, por
+ * Residuos y por Muestreo en paralelo, además de un ordenamiento de cadenas.
+ * Los métodos hacen uso de programación defensiva y están basados en el
+ * pseudocódigo provisto en el libro de Cormen y colaboradores. La
+ * implementación de cada algoritmo se realiza dentro del cuerpo de la clase
+ * para garantizar una correcta compilación y ejecución. Los algoritmos son
+ * plantillas sobre el tipo de la llave, de modo que pueden ordenar arreglos de
+ * int, uint32_t, uint64_t, etc. También se incluye la mezcla de k corridas
+ * ordenadas con un árbol de perdedores, secuencial o repartida entre varios
+ * hilos.
  */
 class Ordenador {
  private:
+  /**
+   * @brief Convierte una llave entera en su representación sin signo de forma
+   * que el orden de los bits coincida con el orden de los valores.
+   * 
+   * @details Para tipos con signo se invierte el bit más significativo, así
+   * los negativos quedan antes que los positivos al ordenar por residuos.
+   * @param num Llave a convertir.
+   * @return Representación sin signo de la llave.
+   */
+  template <typename T>
+  make_unsigned_t<T> llaveSinSigno(T num) const {
+    using U = make_unsigned_t<T>;
+    U llave = static_cast<U>(num);
+    if constexpr (is_signed_v<T>) {
+      llave ^= U(1) << (sizeof(T) * 8 - 1);
+    }
+    return llave;
+  }
+
   /**
    * @brief Obtiene el valor de un dígito específico a partir de un conjunto de
    * bits.
@@ -37,8 +74,9 @@ class Ordenador {
    * @param mascara Máscara utilizada para extraer los bits correspondientes.
    * @return Valor del dígito extraído.
    */
-  int obtenerValorDigito(int num, int bitPos, int mascara) const {
-    return (num >> bitPos) & mascara;
+  template <typename T>
+  int obtenerValorDigito(T num, int bitPos, int mascara) const {
+    return static_cast<int>((llaveSinSigno(num) >> bitPos) & mascara);
   }
 
   /**
@@ -60,10 +98,11 @@ class Ordenador {
    * @param n La cantidad de elementos en el arreglo.
    * @return El valor máximo encontrado en el arreglo.
    */
-  int encontrarValorMaximo(const int* A, int n) const {
-    int max = A[0];
+  template <typename T>
+  T encontrarValorMaximo(const T* A, int n) const {
+    T max = A[0];
     for (int i = 1; i < n; ++i) {
-      if (A[i] > max) {
+      if (max < A[i]) {
         max = A[i];
       }
     }
@@ -77,7 +116,8 @@ class Ordenador {
    * @param p Índice inicial del subarreglo.
    * @param r Índice final del subarreglo.
    */
-  void rapidoRec(int *A, int p, int r) const {
+  template <typename T>
+  void rapidoRec(T *A, int p, int r) const {
     /** Caso de arreglo de un elemento o rango incorrecto. */
     if (p >= r) return;
 
@@ -96,12 +136,13 @@ class Ordenador {
    * @param r Índice final del subarreglo (donde está el pivote).
    * @return Índice del pivote después de la partición.
    */
-  int particionar(int *A, int p, int r) const {
-    int x = A[r];  /** El pivote es el último elemento. */
+  template <typename T>
+  int particionar(T *A, int p, int r) const {
+    T x = A[r];  /** El pivote es el último elemento. */
     int i = p - 1;  /** Índice más alto del lado bajo. */
 
     for (int j = p; j <= r - 1; j++) {
-      if (A[j] <= x) {  /** Si el elemento pertenece al lado bajo. */
+      if (!(x < A[j])) {  /** Si el elemento pertenece al lado bajo. */
         i = i + 1;  /** Incrementar el índice del lado bajo. */
         swap(A[i], A[j]);  /** Intercambiar A[i] con A[j]. */
       }
@@ -113,17 +154,17 @@ class Ordenador {
 
   /** Devuelve el índice del padre de un nodo. */
   int padre(int i) const {
-    return (i - 1) / 2;
+    return padreDArio<2>(i);
   }
 
   /** Devuelve el índice del hijo izquierdo. */
   int izquierdo(int i) const {
-    return 2 * i + 1;
+    return hijoDArio<2>(i, 0);
   }
 
   /** Devuelve el índice del hijo derecho. */
   int derecho(int i) const {
-    return 2 * i + 2;
+    return hijoDArio<2>(i, 1);
   }
 
   /**
@@ -133,20 +174,21 @@ class Ordenador {
    * @param tamMonticulo Tamaño del montículo.
    * @param i Índice de la raíz del subárbol que se va a "monticulizar".
    */
-  void monticuloMax(int *A, int tamMonticulo, int i) const {
+  template <typename T>
+  void monticuloMax(T *A, int tamMonticulo, int i) const {
     int izq = izquierdo(i);
     int der = derecho(i);
     int nodo = i;
 
     /** Si el hijo izquierdo es mayor que el nodo actual. */
-    if (izq < tamMonticulo && A[izq] > A[nodo])
+    if (izq < tamMonticulo && A[nodo] < A[izq])
       nodo = izq;
 
     /**
      * Si el hijo derecho es mayor que el nodo más grande encontrado hasta
      * ahora.
      */
-    if (der < tamMonticulo && A[der] > A[nodo])
+    if (der < tamMonticulo && A[nodo] < A[der])
       nodo = der;
 
     /** Si el nodo más grande no es el nodo actual. */
@@ -158,45 +200,232 @@ class Ordenador {
   }
 
   /** Función para construir un max-heap a partir del arreglo. */
-  void monticulizar(int *A, int n) const {
+  template <typename T>
+  void monticulizar(T *A, int n) const {
     for (int i = (n / 2) - 1; i >= 0; --i) {
       monticuloMax(A, n, i);
     }
   }
 
+  /**
+   * @brief Busca la primera posición de A[0:n-1] cuyo valor no es menor que x.
+   * 
+   * @param A Arreglo ordenado.
+   * @param n Tamaño del arreglo.
+   * @param x Valor buscado.
+   * @return Índice de la primera posición con A[i] >= x, o n si no existe.
+   */
+  template <typename T>
+  int limiteInferior(const T* A, int n, const T& x) const {
+    int bajo = 0, alto = n;
+    while (bajo < alto) {
+      int medio = bajo + (alto - bajo) / 2;
+      if (A[medio] < x) {
+        bajo = medio + 1;
+      } else {
+        alto = medio;
+      }
+    }
+    return bajo;
+  }
+
+  /**
+   * @brief Ejecuta una función en varios hilos y espera a que terminen.
+   * 
+   * @param hilos Cantidad de hilos; el hilo actual ejecuta la parte 0.
+   * @param funcion Función que recibe el número de hilo.
+   */
+  template <typename Funcion>
+  void ejecutarEnParalelo(int hilos, const Funcion& funcion) const {
+    vector<thread> trabajadores;
+    for (int t = 1; t < hilos; ++t) {
+      trabajadores.emplace_back(funcion, t);
+    }
+    funcion(0);
+    for (thread& trabajador : trabajadores) {
+      trabajador.join();
+    }
+  }
+
+  /**
+   * @brief Clasifica un elemento en una cubeta recorriendo sin saltos un
+   * árbol de búsqueda de separadores.
+   * 
+   * @details El árbol se guarda en orden de niveles (arbol[1] es la raíz y
+   * los hijos de j están en 2j y 2j+1), así que cada nivel cuesta una
+   * comparación y una suma, sin saltos condicionales que predecir.
+   * @param arbol Separadores en orden de niveles.
+   * @param niveles Altura del árbol; hay 2^niveles cubetas.
+   * @param x Elemento a clasificar.
+   * @return El índice de la cubeta del elemento.
+   */
+  template <typename T>
+  int clasificarEnCubeta(const T* arbol, int niveles, const T& x) const {
+    int j = 1;
+    for (int nivel = 0; nivel < niveles; ++nivel) {
+      j = 2 * j + (arbol[j] < x);
+    }
+    return j - (1 << niveles);
+  }
+
+  /**
+   * @brief Coloca los separadores ordenados en el árbol en orden de niveles
+   * con un recorrido en orden.
+   * 
+   * @param separadores Separadores ordenados.
+   * @param arbol Arreglo destino, con índices de 1 a 2^niveles - 1.
+   * @param j Nodo actual del árbol.
+   * @param siguiente Siguiente separador a colocar.
+   * @param tamArbol Cantidad de nodos del árbol más uno.
+   */
+  template <typename T>
+  void construirArbolSeparadores(const vector<T>& separadores, vector<T>& arbol,
+    int j, int& siguiente, int tamArbol) const {
+    if (j >= tamArbol) return;
+    construirArbolSeparadores(separadores, arbol, 2 * j, siguiente, tamArbol);
+    arbol[j] = separadores[siguiente++];
+    construirArbolSeparadores(separadores, arbol, 2 * j + 1, siguiente,
+      tamArbol);
+  }
+
+#ifdef __AVX2__
+  /** Mínimo por elementos de dos registros de 8 llaves de 32 bits. */
+  template <typename T>
+  __m256i minimo8(__m256i a, __m256i b) const {
+    if constexpr (is_signed_v<T>) {
+      return _mm256_min_epi32(a, b);
+    } else {
+      return _mm256_min_epu32(a, b);
+    }
+  }
+
+  /** Máximo por elementos de dos registros de 8 llaves de 32 bits. */
+  template <typename T>
+  __m256i maximo8(__m256i a, __m256i b) const {
+    if constexpr (is_signed_v<T>) {
+      return _mm256_max_epi32(a, b);
+    } else {
+      return _mm256_max_epu32(a, b);
+    }
+  }
+
+  /**
+   * @brief Ordena un registro de 8 llaves que forma una secuencia bitónica,
+   * comparando elementos a distancia 4, 2 y 1.
+   */
+  template <typename T>
+  __m256i ordenarBitonico8(__m256i x) const {
+    __m256i t = _mm256_permute2x128_si256(x, x, 1);
+    x = _mm256_blend_epi32(minimo8<T>(x, t), maximo8<T>(x, t), 0xF0);
+    t = _mm256_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2));
+    x = _mm256_blend_epi32(minimo8<T>(x, t), maximo8<T>(x, t), 0xCC);
+    t = _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+    x = _mm256_blend_epi32(minimo8<T>(x, t), maximo8<T>(x, t), 0xAA);
+    return x;
+  }
+
+  /**
+   * @brief Red de mezcla bitónica: a partir de dos registros ordenados deja
+   * en 'a' las 8 llaves menores y en 'b' las 8 mayores, ambas ordenadas.
+   */
+  template <typename T>
+  void mezclarBitonico8(__m256i& a, __m256i& b) const {
+    const __m256i reverso = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    b = _mm256_permutevar8x32_epi32(b, reverso);
+    __m256i menores = minimo8<T>(a, b);
+    __m256i mayores = maximo8<T>(a, b);
+    a = ordenarBitonico8<T>(menores);
+    b = ordenarBitonico8<T>(mayores);
+  }
+
+  /**
+   * @brief Mezcla I[0:nI-1] y D[0:nD-1] en 'salida' de 8 en 8 llaves con la
+   * red bitónica; requiere nI >= 8 y nD >= 8.
+   * 
+   * @details En cada paso se mezclan el bloque pendiente y el siguiente
+   * bloque de la corrida cuya próxima llave es menor; las 8 menores se
+   * escriben y las 8 mayores quedan pendientes. Cuando esa corrida ya no
+   * tiene un bloque completo, el bloque pendiente y las colas se mezclan de
+   * forma escalar. Para llaves enteras la mezcla no necesita ser estable.
+   */
+  template <typename T>
+  void mezclarVectorial(const T* I, int nI, const T* D, int nD, T* salida)
+    const {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(I));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(D));
+    int i = 8, j = 8;
+    while (true) {
+      mezclarBitonico8<T>(a, b);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(salida), a);
+      salida += 8;
+      bool tomarI = (j >= nD) || (i < nI && !(D[j] < I[i]));
+      if (tomarI && i + 8 <= nI) {
+        a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(I + i));
+        i += 8;
+      } else if (!tomarI && j + 8 <= nD) {
+        a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(D + j));
+        j += 8;
+      } else {
+        break;
+      }
+    }
+    /** Mezclar de forma escalar el bloque pendiente con las dos colas. */
+    T pendiente[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(pendiente), b);
+    int k = 0;
+    while (k < 8 || i < nI || j < nD) {
+      if (k < 8 && (i >= nI || !(I[i] < pendiente[k])) &&
+        (j >= nD || !(D[j] < pendiente[k]))) {
+        *salida++ = pendiente[k++];
+      } else if (i < nI && (j >= nD || !(D[j] < I[i]))) {
+        *salida++ = I[i++];
+      } else {
+        *salida++ = D[j++];
+      }
+    }
+  }
+#endif
+
   /**
    * @brief Función recursiva auxiliar para el algoritmo de ordenamiento por
    * mezcla.
    * 
    * @param A Arreglo a ordenar.
+   * @param B Memoria temporal con al menos r + 1 elementos.
    * @param p Índice de inicio del subarreglo.
    * @param r Índice final del subarreglo.
    */
-  void mezclaRec(int *A, int p, int r) const {
+  template <typename T>
+  void mezclaRec(T *A, T *B, int p, int r) const {
     /** Caso de arreglo de un elemento o rango incorrecto. */
     if (p >= r) return;
 
     int q = (p + r) / 2;  /** Calcular el punto medio. */
-    mezclaRec(A, p, q);  /** Ordenar la primera mitad. */
-    mezclaRec(A, q + 1, r);  /** Ordenar la segunda mitad. */
-    mezclar(A, p, q, r);  /** Mezclar ambas partes. */
+    mezclaRec(A, B, p, q);  /** Ordenar la primera mitad. */
+    mezclaRec(A, B, q + 1, r);  /** Ordenar la segunda mitad. */
+    mezclar(A, B, p, q, r);  /** Mezclar ambas partes. */
   }
 
   /**
    * @brief Función auxiliar que mezcla dos subarreglos.
    * 
+   * @details Los subarreglos temporales I y D ocupan B[p:q] y B[q+1:r], por lo
+   * que no se reserva memoria en cada mezcla. Si se compila con AVX2, las
+   * llaves enteras de 32 bits se mezclan con una red bitónica vectorial.
    * @param A Arreglo a ordenar.
+   * @param B Memoria temporal con al menos r + 1 elementos.
    * @param p Índice de inicio del subarreglo.
    * @param q Punto medio del subarreglo.
    * @param r Índice final del subarreglo.
    */
-  void mezclar(int* A, int p, int q, int r) const {
+  template <typename T>
+  void mezclar(T *A, T *B, int p, int q, int r) const {
     int nI = q - p + 1;  /** Tamaño del subarreglo izquierdo. */
     int nD = r - q;  /** Longitud del subarreglo derecho. */
 
-    /** Crear los subarreglos temporales I y D. */
-    vector<int> I(nI);
-    vector<int> D(nD);
+    /** Los subarreglos temporales I y D dentro de B. */
+    T* I = B + p;
+    T* D = B + q + 1;
     /** Copiar los elementos del subarreglo A[p:q] en I. */
     for (int i = 0; i < nI; ++i) {
       I[i] = A[p + i];
@@ -205,6 +434,15 @@ class Ordenador {
     for (int j = 0; j < nD; ++j) {
       D[j] = A[q + 1 + j];
     }
+#ifdef __AVX2__
+    /** Las llaves enteras de 32 bits se mezclan de 8 en 8 con AVX2. */
+    if constexpr (is_integral_v<T> && sizeof(T) == 4) {
+      if (nI >= 8 && nD >= 8) {
+        mezclarVectorial(I, nI, D, nD, A + p);
+        return;
+      }
+    }
+#endif
     /**
      * i: índice del subarreglo I. j: índice del subarreglo D. k: índice del
      * arreglo original.
@@ -213,7 +451,7 @@ class Ordenador {
 
     /** Se mezclan los subarreglos I y D de regreso en A[p:r]. */
     while (i < nI && j < nD) {
-      if (I[i] <= D[j]) {
+      if (!(D[j] < I[i])) {
         A[k] = I[i];
         i = i + 1;
       } else {
@@ -236,17 +474,504 @@ class Ordenador {
     }
   }
 
+  /** Tamaño de las corridas que la mezcla en sitio ordena por inserción. */
+  static constexpr int kCorridaEnSitio = 32;
+
+  /**
+   * @brief Busca la primera posición de A[0:n-1] cuyo valor es mayor que x.
+   * 
+   * @param A Arreglo ordenado.
+   * @param n Tamaño del arreglo.
+   * @param x Valor buscado.
+   * @return Índice de la primera posición con A[i] > x, o n si no existe.
+   */
+  template <typename T>
+  int limiteSuperior(const T* A, int n, const T& x) const {
+    int bajo = 0, alto = n;
+    while (bajo < alto) {
+      int medio = bajo + (alto - bajo) / 2;
+      if (x < A[medio]) {
+        alto = medio;
+      } else {
+        bajo = medio + 1;
+      }
+    }
+    return bajo;
+  }
+
+  /** Invierte el subarreglo A[p:r]. */
+  template <typename T>
+  void invertir(T *A, int p, int r) const {
+    while (p < r) {
+      swap(A[p], A[r]);
+      ++p;
+      --r;
+    }
+  }
+
+  /**
+   * @brief Intercambia los bloques A[p:m-1] y A[m:r] sin memoria adicional,
+   * con tres inversiones.
+   */
+  template <typename T>
+  void rotar(T *A, int p, int m, int r) const {
+    if (p >= m || m > r) return;
+    invertir(A, p, m - 1);
+    invertir(A, m, r);
+    invertir(A, p, r);
+  }
+
+  /** Calcula la raíz cuadrada entera (redondeada hacia abajo) de x >= 0. */
+  static int raizEntera(int x) {
+    int raiz = static_cast<int>(sqrt(static_cast<double>(x)));
+    while (static_cast<long long>(raiz) * raiz > x) --raiz;
+    while (static_cast<long long>(raiz + 1) * (raiz + 1) <= x) ++raiz;
+    return raiz;
+  }
+
+  /** Intercambia los bloques A[p:p+tam-1] y A[q:q+tam-1], que no se solapan. */
+  template <typename T>
+  void intercambiarBloques(T *A, int p, int q, int tam) const {
+    for (int i = 0; i < tam; ++i) {
+      swap(A[p + i], A[q + i]);
+    }
+  }
+
+  /**
+   * @brief Mueve al inicio de A, en orden ascendente, la primera aparición
+   * de hasta 'maximo' valores distintos, sin cambiar el orden relativo de
+   * los demás elementos.
+   * 
+   * @details Las llaves encontradas forman un bloque ordenado que avanza por
+   * el arreglo con rotaciones; cada llave nueva se inserta en su posición
+   * dentro del bloque. Cuesta O(n lg k + n + k^2) para k llaves.
+   * @param A Arreglo.
+   * @param n Tamaño del arreglo.
+   * @param maximo Cantidad máxima de llaves.
+   * @return La cantidad de llaves extraídas, que quedan en A[0:k-1].
+   */
+  template <typename T>
+  int extraerLlaves(T *A, int n, int maximo) const {
+    int inicio = 0;  /** Inicio del bloque de llaves. */
+    int llaves = 1;  /** El primer elemento siempre es una llave. */
+    for (int i = 1; i < n && llaves < maximo; ++i) {
+      /**
+       * Búsqueda binaria sin saltos de la primera llave no menor que A[i]:
+       * con pocos valores distintos se busca cada elemento del arreglo.
+       */
+      const T *base = A + inicio;
+      for (int tam = llaves; tam > 1; tam -= tam / 2) {
+        base = (base[tam / 2] < A[i]) ? base + tam / 2 : base;
+      }
+      int pos = static_cast<int>(base - (A + inicio)) + (*base < A[i]);
+      /** Un valor que ya está entre las llaves se queda en su lugar. */
+      if (pos < llaves && !(A[i] < A[inicio + pos])) continue;
+      /** Llevar el bloque de llaves justo antes de A[i] e insertar A[i]. */
+      rotar(A, inicio, inicio + llaves, i - 1);
+      inicio = i - llaves;
+      rotar(A, inicio + pos, i, i);
+      ++llaves;
+    }
+    rotar(A, 0, inicio, inicio + llaves - 1);
+    return llaves;
+  }
+
+  /**
+   * @brief Mezcla de forma estable A[p:q] y A[q+1:r] cuando A[p:q] ya está
+   * copiado en la memoria 'cache' (y su lugar en A se puede sobrescribir).
+   */
+  template <typename T>
+  void mezclaExterna(T *A, int p, int q, int r, const T *cache) const {
+    int nI = q - p + 1;
+    int i = 0, j = q + 1, k = p;
+    if (nI > 0) {
+      while (j <= r) {
+        if (!(A[j] < cache[i])) {
+          A[k++] = cache[i++];
+          if (i == nI) break;
+        } else {
+          A[k++] = A[j++];
+        }
+      }
+    }
+    while (i < nI) {
+      A[k++] = cache[i++];
+    }
+  }
+
+  /**
+   * @brief Mezcla de forma estable A[p:q] y A[q+1:r] cuando los valores de
+   * A[p:q] están en el buffer interno A[b:b+q-p], y A[p:q] guarda valores
+   * del buffer. Solo usa intercambios, así que los valores del buffer se
+   * conservan, aunque en otro orden.
+   */
+  template <typename T>
+  void mezclaInterna(T *A, int p, int q, int r, int b) const {
+    int nI = q - p + 1;
+    int i = 0, j = q + 1, k = p;
+    if (nI > 0) {
+      while (j <= r) {
+        if (!(A[j] < A[b + i])) {
+          swap(A[k++], A[b + i++]);
+          if (i == nI) break;
+        } else {
+          swap(A[k++], A[j++]);
+        }
+      }
+    }
+    intercambiarBloques(A, b + i, k, nI - i);
+  }
+
+  /**
+   * @brief Mezcla de forma estable A[p:q] y A[q+1:r] sin memoria adicional.
+   * 
+   * @details Busca dónde van los valores más pequeños de la izquierda en la
+   * derecha, rota los de la derecha que son menores antes que ellos y sigue
+   * con los valores siguientes. Cada vuelta coloca todos los elementos de la
+   * izquierda iguales a uno, así que hace a lo sumo d vueltas de costo
+   * O(q - p + 1 + movidos) si la izquierda tiene d valores distintos.
+   */
+  template <typename T>
+  void mezclaPorRotaciones(T *A, int p, int q, int r) const {
+    while (p <= q && q < r) {
+      /** Los de la derecha menores que A[p] van antes que él. */
+      int medio = q + 1 + limiteInferior(A + q + 1, r - q, A[p]);
+      int movidos = medio - (q + 1);
+      rotar(A, p, q + 1, medio - 1);
+      if (medio > r) break;
+      p += movidos;
+      q = medio - 1;
+      /** Los iguales a A[p] ya quedaron en su lugar. */
+      p += limiteSuperior(A + p, q - p + 1, A[p]);
+    }
+  }
+
+  /**
+   * @brief Mezcla de forma estable A[p:q] y A[q+1:r] por bloques, con
+   * O(1) memoria adicional.
+   * 
+   * @details Es la mezcla en bloques de WikiSort. La izquierda se divide en
+   * bloques de tamBloque elementos (más un primer bloque irregular) y el
+   * primer elemento de cada bloque se intercambia con una etiqueta: una
+   * llave distinta y ordenada de A[etiquetas:...]. Los bloques de la
+   * izquierda ruedan a través de los bloques de la derecha con intercambios
+   * de bloques; la etiqueta menor indica cuál bloque de la izquierda sigue,
+   * y cuando el siguiente ya no es mayor que el último bloque de la derecha,
+   * se deja atrás y el bloque anterior se mezcla con los valores de la
+   * derecha que lo siguen. Esa mezcla local usa la memoria 'cache' si el
+   * bloque cabe en ella, el buffer interno A[buffer:buffer+tamBloque-1] si
+   * existe (buffer >= 0), o rotaciones si no.
+   * @param A Arreglo.
+   * @param p Índice de inicio del subarreglo izquierdo.
+   * @param q Índice final del subarreglo izquierdo.
+   * @param r Índice final del subarreglo derecho.
+   * @param tamBloque Tamaño de los bloques.
+   * @param etiquetas Inicio de las etiquetas, al menos una por bloque.
+   * @param buffer Inicio del buffer interno, o -1 si no hay.
+   * @param cache Memoria con espacio para kBufferEnSitio elementos.
+   */
+  template <typename T>
+  void mezclaEnBloques(T *A, int p, int q, int r, int tamBloque,
+    int etiquetas, int buffer, T *cache) const {
+    /** Nada que mezclar, o las mitades ya están en orden. */
+    if (p > q || q >= r || !(A[q + 1] < A[q])) return;
+    if (A[r] < A[p]) {
+      /** Toda la derecha va antes que la izquierda. */
+      rotar(A, p, q + 1, r);
+      return;
+    }
+    bool conBuffer = buffer >= 0;
+    /** Mezcla local de A[inicio:inicio+tam-1] con A[inicio+tam:fin-1]. */
+    auto mezclaLocal = [&](int inicio, int tam, int fin) {
+      if (tam <= kBufferEnSitio) {
+        mezclaExterna(A, inicio, inicio + tam - 1, fin - 1, cache);
+      } else if (conBuffer) {
+        mezclaInterna(A, inicio, inicio + tam - 1, fin - 1, buffer);
+      } else {
+        mezclaPorRotaciones(A, inicio, inicio + tam - 1, fin - 1);
+      }
+    };
+    /** Guarda un bloque de la izquierda donde lo espera mezclaLocal(). */
+    auto apartar = [&](int inicio, int tam) {
+      if (tam <= kBufferEnSitio) {
+        for (int i = 0; i < tam; ++i) {
+          cache[i] = A[inicio + i];
+        }
+      } else if (conBuffer) {
+        intercambiarBloques(A, inicio, buffer, tam);
+      }
+    };
+
+    /** Bloques de la izquierda [inicioA, finA); el primero es irregular. */
+    int inicioA = p, finA = q + 1;
+    int tamPrimero = (finA - inicioA) % tamBloque;
+    for (int i = etiquetas, k = inicioA + tamPrimero; k < finA;
+      ++i, k += tamBloque) {
+      swap(A[i], A[k]);
+    }
+    /** Último bloque de la izquierda que se dejó atrás, y de la derecha. */
+    int ultimoA = inicioA, tamUltimoA = tamPrimero;
+    int inicioUltimoB = 0, finUltimoB = 0;
+    /** Siguiente bloque de la derecha [inicioB, finB). */
+    int inicioB = q + 1, finB = q + 1 + min(tamBloque, r - q);
+    inicioA += tamPrimero;
+    /** Etiqueta (y primer valor) del menor bloque pendiente. */
+    int etiqueta = etiquetas;
+    apartar(ultimoA, tamUltimoA);
+
+    while (inicioA < finA) {
+      if ((finUltimoB > inicioUltimoB &&
+        !(A[finUltimoB - 1] < A[etiqueta])) || inicioB == finB) {
+        /** Dejar atrás el menor bloque de la izquierda. */
+        int corteB = inicioUltimoB + limiteInferior(A + inicioUltimoB,
+          finUltimoB - inicioUltimoB, A[etiqueta]);
+        int restoB = finUltimoB - corteB;
+        int menor = inicioA;
+        for (int k = menor + tamBloque; k < finA; k += tamBloque) {
+          if (A[k] < A[menor]) menor = k;
+        }
+        intercambiarBloques(A, inicioA, menor, tamBloque);
+        /** Devolver su primer valor y la etiqueta a su lugar. */
+        swap(A[inicioA], A[etiqueta]);
+        ++etiqueta;
+        mezclaLocal(ultimoA, tamUltimoA, corteB);
+        if (conBuffer || tamBloque <= kBufferEnSitio) {
+          /**
+           * El bloque queda guardado, así que su lugar se puede ocupar sin
+           * conservar el orden: basta un intercambio en vez de una rotación.
+           */
+          apartar(inicioA, tamBloque);
+          intercambiarBloques(A, corteB, inicioA + tamBloque - restoB,
+            restoB);
+        } else {
+          rotar(A, corteB, inicioA, inicioA + tamBloque - 1);
+        }
+        ultimoA = inicioA - restoB;
+        tamUltimoA = tamBloque;
+        inicioUltimoB = ultimoA + tamBloque;
+        finUltimoB = inicioUltimoB + restoB;
+        inicioA += tamBloque;
+      } else if (finB - inicioB < tamBloque) {
+        /** Llevar el último bloque de la derecha, irregular, antes. */
+        int tam = finB - inicioB;
+        rotar(A, inicioA, inicioB, finB - 1);
+        inicioUltimoB = inicioA;
+        finUltimoB = inicioA + tam;
+        inicioA += tam;
+        finA += tam;
+        finB = inicioB;
+      } else {
+        /** Rodar el primer bloque de la izquierda tras el de la derecha. */
+        intercambiarBloques(A, inicioA, inicioB, tamBloque);
+        inicioUltimoB = inicioA;
+        finUltimoB = inicioA + tamBloque;
+        inicioA += tamBloque;
+        finA += tamBloque;
+        inicioB += tamBloque;
+        finB = (finB > r + 1 - tamBloque) ? r + 1 : finB + tamBloque;
+      }
+    }
+    /** Mezclar el último bloque de la izquierda con lo que queda. */
+    mezclaLocal(ultimoA, tamUltimoA, r + 1);
+  }
+
+  /** Tamaño de los grupos de cadenas que se ordenan por inserción. */
+  static constexpr int kUmbralCadenas = 24;
+
+  /**
+   * @brief Devuelve el carácter de la posición d de una cadena, desplazado en
+   * 1 para que el fin de la cadena (0) quede antes que cualquier carácter.
+   */
+  int caracterEn(string_view cadena, size_t d) const {
+    return d < cadena.size() ? static_cast<unsigned char>(cadena[d]) + 1 : 0;
+  }
+
+  /**
+   * @brief Ordena por inserción cadenas que comparten sus primeros d
+   * caracteres, aprovechando los prefijos comunes (LCP) ya calculados.
+   * 
+   * @details L[k] guarda el prefijo común entre S[k-1] y S[k] en la parte ya
+   * ordenada. Al insertar x se recuerda h, su prefijo común con el último
+   * elemento que resultó mayor; comparando h con L se decide la mayoría de
+   * los pasos sin volver a leer caracteres, y cuando hay que compararlos se
+   * empieza desde h en lugar de desde el inicio.
+   * @param S Cadenas a ordenar.
+   * @param n Cantidad de cadenas (a lo sumo kUmbralCadenas).
+   * @param d Cantidad de caracteres iniciales que todas comparten.
+   */
+  void insercionCadenas(string_view *S, int n, size_t d) const {
+    size_t L[kUmbralCadenas];
+    for (int j = 1; j < n; ++j) {
+      string_view x = S[j];
+      /** Prefijo común de x con S[j-1]. */
+      size_t h = d;
+      while (caracterEn(x, h) != 0 && caracterEn(x, h) ==
+        caracterEn(S[j - 1], h)) {
+        ++h;
+      }
+      if (caracterEn(S[j - 1], h) <= caracterEn(x, h)) {
+        L[j] = h;  /** x ya está en su lugar. */
+        continue;
+      }
+      size_t lcpDespues = h;  /** Prefijo común con el elemento siguiente. */
+      size_t lcpAntes = 0;  /** Prefijo común con el elemento anterior. */
+      int c = j - 2;
+      while (c >= 0) {
+        size_t l = L[c + 1];
+        if (l < h) {
+          lcpAntes = l;  /** S[c] difiere antes, así que S[c] < x. */
+          break;
+        }
+        if (l == h) {
+          size_t h2 = h;
+          while (caracterEn(x, h2) != 0 && caracterEn(x, h2) ==
+            caracterEn(S[c], h2)) {
+            ++h2;
+          }
+          if (caracterEn(S[c], h2) <= caracterEn(x, h2)) {
+            lcpAntes = h2;
+            break;
+          }
+          h = h2;
+        }
+        /** Si l > h, x < S[c] y su prefijo común sigue siendo h. */
+        lcpDespues = h;
+        --c;
+      }
+      /** Desplazar S[c+1:j-1] y sus prefijos comunes una posición. */
+      int pos = c + 1;
+      for (int k = j; k > pos; --k) {
+        S[k] = S[k - 1];
+      }
+      for (int k = j; k > pos + 1; --k) {
+        L[k] = L[k - 1];
+      }
+      S[pos] = x;
+      if (pos > 0) L[pos] = lcpAntes;
+      L[pos + 1] = lcpDespues;
+    }
+  }
+
+  /**
+   * @brief Ordenamiento rápido de múltiples llaves sobre cadenas que
+   * comparten sus primeros d caracteres.
+   * 
+   * @details Se particiona en tres grupos según el carácter d: menores,
+   * iguales y mayores al pivote. Solo el grupo de iguales avanza al carácter
+   * siguiente. El carácter d de cada cadena se guarda en 'car' y se mueve
+   * junto con ella, así cada nivel lee cada cadena una sola vez.
+   * @param S Cadenas a ordenar.
+   * @param car Caracteres guardados, uno por cadena.
+   * @param n Cantidad de cadenas.
+   * @param d Cantidad de caracteres iniciales que todas comparten.
+   * @param guardados Indica si 'car' ya tiene los caracteres de la posición d.
+   */
+  void cadenasRec(string_view *S, uint16_t *car, int n, size_t d,
+    bool guardados) const {
+    while (n >= kUmbralCadenas) {
+      if (!guardados) {
+        for (int i = 0; i < n; ++i) {
+          car[i] = static_cast<uint16_t>(caracterEn(S[i], d));
+        }
+      }
+      /** Pivote: mediana de tres. */
+      uint16_t a = car[0], b = car[n / 2], c = car[n - 1];
+      uint16_t v = (a < b) ? ((b < c) ? b : ((a < c) ? c : a))
+        : ((a < c) ? a : ((b < c) ? c : b));
+      /** Partición en tres grupos (bandera holandesa). */
+      int menores = 0, i = 0, mayores = n - 1;
+      while (i <= mayores) {
+        if (car[i] < v) {
+          swap(S[i], S[menores]);
+          swap(car[i++], car[menores++]);
+        } else if (v < car[i]) {
+          swap(S[i], S[mayores]);
+          swap(car[i], car[mayores--]);
+        } else {
+          ++i;
+        }
+      }
+      cadenasRec(S, car, menores, d, true);
+      cadenasRec(S + mayores + 1, car + mayores + 1, n - mayores - 1, d, true);
+      /** Si el pivote es el fin de cadena, las iguales ya están ordenadas. */
+      if (v == 0) return;
+      S += menores;
+      car += menores;
+      n = mayores - menores + 1;
+      ++d;
+      guardados = false;
+    }
+    insercionCadenas(S, n, d);
+  }
+
+  /**
+   * @brief Ordena por mezcla tomando la memoria temporal de la arena dada.
+   * 
+   * @details Los tipos que no se pueden copiar byte a byte (por ejemplo,
+   * string) no pueden vivir en memoria sin inicializar, así que para ellos se
+   * usa un vector.
+   * @param A Arreglo a ordenar.
+   * @param n Tamaño del arreglo.
+   * @param arena Arena de la que se toma la memoria temporal.
+   */
+  template <typename T>
+  void mezclaConArena(T *A, int n, ArenaTemporal& arena) const {
+    if constexpr (is_trivially_copyable_v<T>) {
+      arena.preparar(ArenaTemporal::bytesPara<T>(n));
+      mezclaRec(A, arena.asignar<T>(n), 0, n - 1);
+    } else {
+      vector<T> temporal(n);
+      mezclaRec(A, temporal.data(), 0, n - 1);
+    }
+  }
+
+  /**
+   * @brief Devuelve la arena del hilo t para los algoritmos paralelos,
+   * creándola la primera vez que se necesita.
+   */
+  ArenaTemporal& arenaDeHilo(int t) const {
+    while (static_cast<int>(arenasHilos.size()) <= t) {
+      arenasHilos.push_back(make_unique<ArenaTemporal>(paginasGrandes));
+    }
+    return *arenasHilos[t];
+  }
+
+  /** Indica si las arenas deben usar páginas grandes. */
+  bool paginasGrandes = false;
+
+  /**
+   * Memoria temporal que se reutiliza entre llamados. Los métodos son const
+   * porque no cambian el estado observable del ordenador.
+   */
+  mutable ArenaTemporal arena;
+
+  /** Arenas de los hilos de los algoritmos paralelos, una por hilo. */
+  mutable vector<unique_ptr<ArenaTemporal>> arenasHilos;
+
  public:
   Ordenador() = default;
   ~Ordenador() = default;
 
+  /**
+   * @brief Crea un ordenador cuya memoria temporal se respalda con páginas
+   * grandes (MAP_HUGETLB o, si no hay páginas reservadas, MADV_HUGEPAGE).
+   * 
+   * @param paginasGrandes Indica si se deben usar páginas grandes.
+   */
+  explicit Ordenador(bool paginasGrandes)
+    : paginasGrandes(paginasGrandes), arena(paginasGrandes) {}
+
+  /** Tamaño del buffer fijo que usa la mezcla en sitio. */
+  static constexpr int kBufferEnSitio = 256;
+
   /**
    * @brief Algoritmo de ordenamiento por selección.
    * 
    * @param A Arreglo a ordenar.
    * @param n Tamaño del arreglo.
    */
-  void ordenamientoPorSeleccion(int *A, int n) const {
+  template <typename T>
+  void ordenamientoPorSeleccion(T *A, int n) const {
     /** Verificación defensiva de entrada. */
     if (A == nullptr || n <= 0) return;
 
@@ -268,17 +993,18 @@ class Ordenador {
    * @param A Arreglo a ordenar.
    * @param n Tamaño del arreglo.
    */
-  void ordenamientoPorInsercion(int *A, int n) const {
+  template <typename T>
+  void ordenamientoPorInsercion(T *A, int n) const {
     /** Verificación defensiva de entrada. */
     if (A == nullptr || n <= 0) return;
 
     for (int i = 1; i < n; ++i) {
-      int valorClave = A[i];  /** Se guarda el elemento actual. */
+      T valorClave = A[i];  /** Se guarda el elemento actual. */
       int j = i - 1;
       /**
        * Se mueven los elementos mayores que valorClave una posición adelante.
        */
-      while (j >= 0 && A[j] > valorClave) {
+      while (j >= 0 && valorClave < A[j]) {
         A[j + 1] = A[j];
         --j;
       }
@@ -293,12 +1019,113 @@ class Ordenador {
    * @param A Arreglo a ordenar.
    * @param n Tamaño del arreglo.
    */
-  void ordenamientoPorMezcla(int *A, int n) const {
+  template <typename T>
+  void ordenamientoPorMezcla(T *A, int n) const {
     /** Verificación defensiva de entrada. */
     if (A == nullptr || n <= 0) return;
 
     /** Llamado a la función recursiva para ordenar el arreglo completo. */
-    mezclaRec(A, 0, n - 1);
+    mezclaConArena(A, n, arena);
+  }
+
+  /**
+   * @brief Algoritmo de ordenamiento por mezcla en sitio.
+   * 
+   * @details Es estable, toma O(n lg n) tiempo en el peor caso y solo usa un
+   * buffer fijo de kBufferEnSitio elementos, sin importar el tamaño del
+   * arreglo, por lo que sirve para arreglos en los que no cabe una copia
+   * adicional. Es un ordenamiento por mezcla en bloques al estilo de
+   * WikiSort:
+   * 1. Se extraen al inicio hasta 2(sqrt(n) + 1) valores distintos (las
+   *    llaves). La primera mitad de las llaves sirve de buffer interno y la
+   *    segunda, de etiquetas para seguir el orden de los bloques.
+   * 2. El resto se ordena de abajo hacia arriba: corridas de kCorridaEnSitio
+   *    elementos por inserción, mezclas con el buffer fijo mientras la
+   *    izquierda quepa en él, y luego mezclas en bloques de sqrt(ancho)
+   *    elementos (mezclaEnBloques()), cada una de costo lineal.
+   * 3. Las llaves se reordenan por inserción y se mezclan con el resto por
+   *    rotaciones, antes que los valores iguales, en O(n).
+   * Si el arreglo tiene menos valores distintos que los necesarios, las
+   * llaves son todos sus valores distintos y los bloques crecen a
+   * ancho / etiquetas elementos. Cuando un bloque ya no cabe en el buffer
+   * interno, se mezcla por rotaciones, que siguen siendo lineales porque los
+   * bloques tienen pocos valores distintos.
+   * @param A Arreglo a ordenar.
+   * @param n Tamaño del arreglo.
+   */
+  template <typename T>
+  void ordenamientoPorMezclaEnSitio(T *A, int n) const {
+    /** Verificación defensiva de entrada. */
+    if (A == nullptr || n <= 0) return;
+
+    /** 1. Extraer las llaves: buffer en A[0:h-1], etiquetas en A[h:u-1]. */
+    int raiz = raizEntera(n);
+    int u = extraerLlaves(A, n, 2 * (raiz + 1));
+    int h = u / 2;
+    int numEtiquetas = u - h;
+
+    /** 2. Ordenar el resto, R = A[u:n-1]. */
+    T *R = A + u;
+    int m = n - u;
+    for (int inicio = 0; inicio < m; inicio += kCorridaEnSitio) {
+      int tam = (m - inicio < kCorridaEnSitio) ? m - inicio : kCorridaEnSitio;
+      ordenamientoPorInsercion(R + inicio, tam);
+    }
+    T cache[kBufferEnSitio];
+    for (int ancho = kCorridaEnSitio; ancho < m; ancho *= 2) {
+      /**
+       * Bloques de unos sqrt(ancho) elementos, o más grandes si no alcanzan
+       * las etiquetas; el buffer interno se usa si un bloque cabe en él.
+       */
+      int tamBloque = raizEntera(ancho);
+      if (tamBloque * tamBloque < ancho) ++tamBloque;
+      if (numEtiquetas < ancho / tamBloque) {
+        tamBloque = ancho / numEtiquetas + 1;
+      }
+      bool conBuffer = h >= tamBloque;
+      for (int p = 0; p < m - ancho; p += 2 * ancho) {
+        int q = p + ancho - 1;
+        int r = (p + 2 * ancho - 1 < m - 1) ? p + 2 * ancho - 1 : m - 1;
+        if (ancho <= kBufferEnSitio) {
+          /** La izquierda cabe en el buffer fijo: mezcla lineal directa. */
+          if (!(R[q + 1] < R[q])) continue;
+          for (int i = 0; i < ancho; ++i) {
+            cache[i] = R[p + i];
+          }
+          mezclaExterna(R, p, q, r, cache);
+        } else {
+          mezclaEnBloques(A, u + p, u + q, u + r, tamBloque, h,
+            conBuffer ? 0 : -1, cache);
+        }
+      }
+      if (ancho > m / 2) break;  /** Evitar el desbordamiento de ancho. */
+    }
+
+    /** 3. Reordenar las llaves (el buffer quedó desordenado) y mezclarlas. */
+    ordenamientoPorInsercion(A, u);
+    mezclaPorRotaciones(A, 0, u - 1, n - 1);
+  }
+
+  /**
+   * @brief Algoritmo de ordenamiento de cadenas.
+   * 
+   * @details Ordena vistas de cadenas (string_view) con el ordenamiento
+   * rápido de múltiples llaves de Bentley y Sedgewick: en lugar de comparar
+   * cadenas completas, cada nivel compara un solo carácter, por lo que los
+   * prefijos comunes no se vuelven a leer. Los caracteres del nivel actual
+   * se guardan en un arreglo contiguo tomado de la arena, y los grupos
+   * pequeños se terminan con una inserción que aprovecha los prefijos
+   * comunes. El resultado es el orden lexicográfico por bytes.
+   * @param A Arreglo de cadenas a ordenar.
+   * @param n Tamaño del arreglo.
+   */
+  void ordenamientoDeCadenas(string_view *A, int n) const {
+    /** Verificación defensiva de entrada. */
+    if (A == nullptr || n <= 0) return;
+
+    arena.preparar(ArenaTemporal::bytesPara<uint16_t>(n));
+    uint16_t* car = arena.asignar<uint16_t>(n);
+    cadenasRec(A, car, n, 0, false);
   }
 
   /**
@@ -307,7 +1134,8 @@ class Ordenador {
    * @param A Arreglo a ordenar.
    * @param n Tamaño del arreglo.
    */
-  void ordenamientoPorMonticulos(int *A, int n) const {
+  template <typename T>
+  void ordenamientoPorMonticulos(T *A, int n) const {
     /** Verificación defensiva de entrada. */
     if (A == nullptr || n <= 0) return;
 
@@ -325,7 +1153,8 @@ class Ordenador {
    * @param A Arreglo a ordenar.
    * @param n Tamaño del arreglo.
    */
-  void ordenamientoRapido(int *A, int n) const {
+  template <typename T>
+  void ordenamientoRapido(T *A, int n) const {
     /** Verificación defensiva de entrada. */
     if (A == nullptr || n <= 0) return;
 
@@ -336,26 +1165,34 @@ class Ordenador {
   /**
    * @brief Algoritmo de ordenamiento por residuos en base 2^lg(n).
    * 
+   * @details La base se limita a 2^16 para que el arreglo de conteo no crezca
+   * con n (con 10^8 llaves serían 2^26 contadores) y siga cabiendo en caché.
    * @param A Arreglo a ordenar.
    * @param n Tamaño del arreglo.
    */
-  void ordenamientoPorRadix(int *A, int n) const {
+  template <typename T>
+  void ordenamientoPorRadix(T *A, int n) const {
+    static_assert(is_integral_v<T>, "Residuos requiere llaves enteras.");
     /** Verificación defensiva de entrada. */
-    if (A == nullptr || n <= 0) return;
+    if (A == nullptr || n <= 1) return;
 
     /** Calcular el número de bits por cada dígito (lgn). */
     int bitsPorDigito = calcularLog(n);  /** Base 2^lg(n). */
-    int totalBits = sizeof(int) * 8;  /** Número de bits en un entero. */
+    if (bitsPorDigito > 16) bitsPorDigito = 16;
+    int totalBits = sizeof(T) * 8;  /** Número de bits de la llave. */
+    int tamBase = 1 << bitsPorDigito;
 
-    /** Crear un buffer para el ordenamiento temporal. */
-    int* memIntermedia = new int[n];
+    /** Tomar de la arena el buffer temporal y el arreglo de conteo. */
+    arena.preparar(ArenaTemporal::bytesPara<T>(n) +
+      ArenaTemporal::bytesPara<int>(tamBase));
+    T* memIntermedia = arena.asignar<T>(n);
+    int* count = arena.asignar<int>(tamBase);
 
     /** Máscara para extraer los bits correspondientes a un dígito. */
-    int mascara = (1 << bitsPorDigito) - 1;
+    int mascara = tamBase - 1;
 
     for (int bitPos = 0; bitPos < totalBits; bitPos += bitsPorDigito) {
-      int count[1 << bitsPorDigito];
-      for (int i = 0; i < (1 << bitsPorDigito); ++i) {
+      for (int i = 0; i < tamBase; ++i) {
         count[i] = 0;
       }
 
@@ -366,7 +1203,7 @@ class Ordenador {
       }
 
       /** Calcular posiciones acumulativas. */
-      for (int i = 1; i < (1 << bitsPorDigito); ++i) {
+      for (int i = 1; i < tamBase; ++i) {
         count[i] += count[i - 1];
       }
 
@@ -381,8 +1218,312 @@ class Ordenador {
         A[i] = memIntermedia[i];
       }
     }
-    /** Liberar la memoria utilizada por el buffer. */
-    delete[] memIntermedia;
+  }
+
+  /**
+   * @brief Algoritmo de ordenamiento por muestreo en paralelo, utilizando
+   * todos los núcleos disponibles.
+   * 
+   * @param A Arreglo a ordenar.
+   * @param n Tamaño del arreglo.
+   */
+  template <typename T>
+  void ordenamientoPorMuestreoParalelo(T *A, int n) const {
+    ordenamientoPorMuestreoParalelo(A, n, 0);
+  }
+
+  /**
+   * @brief Algoritmo de ordenamiento por muestreo en paralelo.
+   * 
+   * @details Solo utiliza comparaciones, por lo que sirve para llaves que no
+   * se pueden ordenar por residuos (por ejemplo, llaves compuestas). Se toma
+   * una muestra del arreglo y de ella se eligen los separadores de las
+   * cubetas. Cada hilo clasifica su parte del arreglo con un árbol de
+   * separadores sin saltos y cuenta cuántos elementos van a cada cubeta; con
+   * esas cuentas cada hilo sabe dónde escribir y dispersa sus elementos en un
+   * buffer. Al final cada cubeta se devuelve a A y se ordena por mezcla de
+   * forma independiente, repartiendo las cubetas entre los hilos.
+   * Si la muestra tiene separadores repetidos (muchas llaves iguales), se
+   * eliminan los repetidos y cada separador recibe además una cubeta de
+   * igualdad, como en IPS4o, con los elementos x tales que !(x < s) y
+   * !(s < x); esas cubetas no se ordenan, así que una llave muy frecuente no
+   * termina en una sola cubeta que ordena un solo hilo.
+   * @param A Arreglo a ordenar.
+   * @param n Tamaño del arreglo.
+   * @param hilos Cantidad de hilos; 0 utiliza todos los núcleos disponibles.
+   */
+  template <typename T>
+  void ordenamientoPorMuestreoParalelo(T *A, int n, int hilos) const {
+    /** Verificación defensiva de entrada. */
+    if (A == nullptr || n <= 0) return;
+
+    if (hilos <= 0) hilos = static_cast<int>(thread::hardware_concurrency());
+    if (hilos <= 0) hilos = 1;
+    /** Con pocos elementos no vale la pena crear hilos. */
+    if (hilos == 1 || n < (1 << 16)) {
+      ordenamientoPorMezcla(A, n);
+      return;
+    }
+
+    /**
+     * Se usan al menos 2 cubetas por hilo para equilibrar la carga, y a lo
+     * sumo 128 para que, con las cubetas de igualdad, quepan en un uint8_t.
+     */
+    int niveles = 1;
+    while ((1 << niveles) < 2 * hilos && niveles < 7) ++niveles;
+    int cubetas = 1 << niveles;
+
+    /** Sobremuestrear y elegir cubetas-1 separadores equiespaciados. */
+    const int sobremuestreo = 32;
+    int tamMuestra = cubetas * sobremuestreo;
+    vector<T> muestra(tamMuestra);
+    mt19937 generador(n);
+    uniform_int_distribution<int> posicion(0, n - 1);
+    for (int i = 0; i < tamMuestra; ++i) {
+      muestra[i] = A[posicion(generador)];
+    }
+    ordenamientoPorMezcla(muestra.data(), tamMuestra);
+    vector<T> separadores(cubetas - 1);
+    for (int i = 1; i < cubetas; ++i) {
+      separadores[i - 1] = muestra[i * sobremuestreo];
+    }
+
+    /**
+     * Eliminar los separadores repetidos y completar con el mayor; las
+     * cubetas entre separadores iguales quedan vacías. Un elemento de la
+     * cubeta b cumple x <= separadores[b], así que es igual al separador si
+     * además !(x < separadores[b]); en la última cubeta se compara con el
+     * mayor separador, que es menor que x.
+     */
+    int distintos = 1;
+    for (int i = 1; i < cubetas - 1; ++i) {
+      if (separadores[distintos - 1] < separadores[i]) {
+        separadores[distintos++] = separadores[i];
+      }
+    }
+    bool conIgualdad = distintos < cubetas - 1;
+    for (int i = distintos; i < cubetas - 1; ++i) {
+      separadores[i] = separadores[distintos - 1];
+    }
+    vector<T> arbol(cubetas);
+    int siguiente = 0;
+    construirArbolSeparadores(separadores, arbol, 1, siguiente, cubetas);
+
+    /**
+     * El buffer y la cubeta de cada elemento se toman de la arena; los tipos
+     * que no se pueden copiar byte a byte usan un vector para el buffer.
+     */
+    vector<T> bufferVector;
+    T* buffer = nullptr;
+    if constexpr (is_trivially_copyable_v<T>) {
+      arena.preparar(ArenaTemporal::bytesPara<T>(n) +
+        ArenaTemporal::bytesPara<uint8_t>(n));
+      buffer = arena.asignar<T>(n);
+    } else {
+      arena.preparar(ArenaTemporal::bytesPara<uint8_t>(n));
+      bufferVector.resize(n);
+      buffer = bufferVector.data();
+    }
+    uint8_t* cubetaDe = arena.asignar<uint8_t>(n);
+
+    /**
+     * Clasificar cada elemento y contar cubetas por hilo. Con cubetas de
+     * igualdad, la cubeta b pasa a ser la 2b y su cubeta de igualdad la 2b+1.
+     */
+    separadores.push_back(separadores.back());
+    int totalCubetas = conIgualdad ? 2 * cubetas : cubetas;
+    vector<vector<int>> cuentas(hilos, vector<int>(totalCubetas, 0));
+    auto inicioParte = [n, hilos](int t) {
+      return static_cast<int>(static_cast<long long>(n) * t / hilos);
+    };
+    ejecutarEnParalelo(hilos, [&](int t) {
+      vector<int>& cuenta = cuentas[t];
+      if (conIgualdad) {
+        for (int i = inicioParte(t); i < inicioParte(t + 1); ++i) {
+          int b = clasificarEnCubeta(arbol.data(), niveles, A[i]);
+          const T& s = separadores[b];
+          int c = 2 * b + (!(A[i] < s) && !(s < A[i]));
+          cubetaDe[i] = static_cast<uint8_t>(c);
+          ++cuenta[c];
+        }
+      } else {
+        for (int i = inicioParte(t); i < inicioParte(t + 1); ++i) {
+          int c = clasificarEnCubeta(arbol.data(), niveles, A[i]);
+          cubetaDe[i] = static_cast<uint8_t>(c);
+          ++cuenta[c];
+        }
+      }
+    });
+
+    /**
+     * Sumas prefijas en orden (cubeta, hilo): el hilo t escribe la cubeta c
+     * a partir de cuentas[t][c].
+     */
+    vector<int> inicioCubeta(totalCubetas + 1, 0);
+    int acumulado = 0;
+    for (int c = 0; c < totalCubetas; ++c) {
+      inicioCubeta[c] = acumulado;
+      for (int t = 0; t < hilos; ++t) {
+        int cantidad = cuentas[t][c];
+        cuentas[t][c] = acumulado;
+        acumulado += cantidad;
+      }
+    }
+    inicioCubeta[totalCubetas] = n;
+
+    /** Dispersar los elementos en el buffer. */
+    ejecutarEnParalelo(hilos, [&](int t) {
+      vector<int>& destino = cuentas[t];
+      for (int i = inicioParte(t); i < inicioParte(t + 1); ++i) {
+        buffer[destino[cubetaDe[i]]++] = A[i];
+      }
+    });
+
+    /**
+     * Devolver cada cubeta a A y ordenarla; los hilos toman cubetas libres.
+     * Las cubetas de igualdad (impares) solo se copian, porque ya están
+     * ordenadas.
+     */
+    atomic<int> proximaCubeta(0);
+    for (int t = 0; t < hilos; ++t) arenaDeHilo(t);
+    ejecutarEnParalelo(hilos, [&](int t) {
+      ArenaTemporal& arenaHilo = *arenasHilos[t];
+      for (int c = proximaCubeta++; c < totalCubetas; c = proximaCubeta++) {
+        int inicio = inicioCubeta[c];
+        int tam = inicioCubeta[c + 1] - inicio;
+        for (int i = 0; i < tam; ++i) {
+          A[inicio + i] = buffer[inicio + i];
+        }
+        bool iguales = conIgualdad && c % 2 == 1;
+        if (tam > 0 && !iguales) mezclaConArena(A + inicio, tam, arenaHilo);
+      }
+    });
+  }
+
+  /**
+   * @brief Mezcla k corridas ordenadas en un solo arreglo ordenado.
+   * 
+   * @details Utiliza un árbol de perdedores, por lo que cada elemento cuesta
+   * alrededor de lg(k) comparaciones. La mezcla es estable: ante llaves
+   * iguales se respeta el orden de las corridas. Para corridas que no están
+   * en memoria se puede usar directamente ArbolDePerdedores con entradas de
+   * tipo EntradaConBuffer.
+   * @param corridas Pares (inicio, tamaño) de cada corrida ordenada.
+   * @param salida Arreglo de salida, con espacio para todos los elementos.
+   */
+  template <typename T>
+  void mezclaKVias(const vector<pair<const T*, int>>& corridas, T* salida)
+    const {
+    /** Verificación defensiva de entrada. */
+    if (salida == nullptr) return;
+
+    vector<EntradaArreglo<T>> entradas;
+    entradas.reserve(corridas.size());
+    for (const auto& corrida : corridas) {
+      entradas.emplace_back(corrida.first, corrida.second);
+    }
+    ArbolDePerdedores<T, EntradaArreglo<T>> arbol(entradas);
+    while (!arbol.vacio()) {
+      *salida++ = arbol.minimo();
+      arbol.avanzar();
+    }
+  }
+
+  /**
+   * @brief Mezcla k corridas ordenadas repartiendo la salida entre varios
+   * hilos.
+   * 
+   * @details Se toma una muestra de cada corrida para elegir hilos-1
+   * separadores y se busca cada separador en cada corrida. Así la salida
+   * queda dividida en tramos independientes, y cada hilo mezcla su tramo con
+   * su propio árbol de perdedores. Igual que la versión secuencial, la mezcla
+   * es estable.
+   * @param corridas Pares (inicio, tamaño) de cada corrida ordenada.
+   * @param salida Arreglo de salida, con espacio para todos los elementos.
+   * @param hilos Cantidad de hilos; 0 utiliza todos los núcleos disponibles.
+   */
+  template <typename T>
+  void mezclaKViasParalela(const vector<pair<const T*, int>>& corridas,
+    T* salida, int hilos = 0) const {
+    /** Verificación defensiva de entrada. */
+    if (salida == nullptr) return;
+
+    if (hilos <= 0) hilos = static_cast<int>(thread::hardware_concurrency());
+    if (hilos <= 0) hilos = 1;
+    size_t total = 0;
+    for (const auto& corrida : corridas) {
+      if (corrida.second > 0) total += corrida.second;
+    }
+    /** Con pocos elementos no vale la pena crear hilos. */
+    if (hilos == 1 || total < (size_t(1) << 16)) {
+      mezclaKVias(corridas, salida);
+      return;
+    }
+
+    /** Muestrear las corridas en proporción a su tamaño. */
+    size_t paso = total / (size_t(hilos) * 32);
+    if (paso == 0) paso = 1;
+    vector<T> muestra;
+    for (const auto& corrida : corridas) {
+      size_t tam = corrida.second > 0 ? corrida.second : 0;
+      for (size_t i = paso / 2; i < tam; i += paso) {
+        muestra.push_back(corrida.first[i]);
+      }
+    }
+    ordenamientoPorMezcla(muestra.data(), static_cast<int>(muestra.size()));
+
+    /**
+     * cortes[j][i] es la posición en la corrida i donde empieza el tramo j.
+     * Los separadores están ordenados, por lo que los cortes son crecientes.
+     */
+    size_t k = corridas.size();
+    vector<vector<int>> cortes(hilos + 1, vector<int>(k, 0));
+    for (size_t i = 0; i < k; ++i) {
+      cortes[hilos][i] = corridas[i].second > 0 ? corridas[i].second : 0;
+    }
+    for (int j = 1; j < hilos; ++j) {
+      const T& separador = muestra[j * muestra.size() / hilos];
+      for (size_t i = 0; i < k; ++i) {
+        cortes[j][i] = limiteInferior(corridas[i].first, cortes[hilos][i],
+          separador);
+      }
+    }
+
+    /** Cada hilo mezcla su tramo en la posición que le corresponde. */
+    vector<thread> trabajadores;
+    size_t inicio = 0;
+    for (int j = 0; j < hilos; ++j) {
+      vector<pair<const T*, int>> tramo(k);
+      size_t tamTramo = 0;
+      for (size_t i = 0; i < k; ++i) {
+        tramo[i] = {corridas[i].first + cortes[j][i],
+          cortes[j + 1][i] - cortes[j][i]};
+        tamTramo += tramo[i].second;
+      }
+      trabajadores.emplace_back([this, tramo, salida, inicio]() {
+        mezclaKVias(tramo, salida + inicio);
+      });
+      inicio += tamTramo;
+    }
+    for (thread& trabajador : trabajadores) {
+      trabajador.join();
+    }
+  }
+
+  /**
+   * @brief Devuelve la memoria temporal que tiene reservada el ordenador, en
+   * bytes, sumando su arena y las de los hilos.
+   * 
+   * @details Las arenas solo crecen, así que el valor es el máximo que han
+   * necesitado los ordenamientos hechos con este ordenador. No incluye el
+   * buffer fijo de la mezcla en sitio, que vive en la pila.
+   */
+  size_t getMemoriaTemporal() const {
+    size_t total = arena.getCapacidad();
+    for (const auto& arenaHilo : arenasHilos) {
+      total += arenaHilo->getCapacidad();
+    }
+    return total;
   }
 
   /**
@@ -1,5 +1,8 @@
 // Copyright 2024 Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
 
+#include <algorithm>
+#include <string>
+
 #include "Ordenador.hpp"
 
 /** Función para generar un arreglo dinámico de enteros positivos uint32_t. */
@@ -41,11 +44,122 @@ double medirTiempo(Ordenador& ordenador, void (Ordenador::*metodo)(int*, int)
   return duracion.count();  /** Retornar el tiempo en milisegundos. */
 }
 
+/**
+ * Función para medir cómo escala el ordenamiento por muestreo en paralelo al
+ * aumentar la cantidad de hilos, desde 1 hasta todos los núcleos disponibles.
+ */
+void medirEscalabilidad(Ordenador& ordenador, int tam, uint32_t semilla) {
+  uint32_t* arregloOriginal = arregloAleatorio(tam, semilla);
+  int* arreglo = new int[tam];
+  int maxHilos = static_cast<int>(thread::hardware_concurrency());
+  if (maxHilos <= 0) maxHilos = 1;
+  cout << "----- Escalabilidad del Ordenamiento por Muestreo -----\n\n";
+  /** Potencias de 2 menores que la cantidad de núcleos, y luego todos. */
+  vector<int> cantidadesHilos;
+  for (int hilos = 1; hilos < maxHilos; hilos *= 2) {
+    cantidadesHilos.push_back(hilos);
+  }
+  cantidadesHilos.push_back(maxHilos);
+  double tiempoBase = 0.0;
+  for (int hilos : cantidadesHilos) {
+    for (int i = 0; i < tam; ++i) {
+      arreglo[i] = static_cast<int>(arregloOriginal[i]);
+    }
+    auto inicio = chrono::high_resolution_clock::now();
+    ordenador.ordenamientoPorMuestreoParalelo(arreglo, tam, hilos);
+    auto fin = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> duracion = fin - inicio;
+    if (hilos == 1) tiempoBase = duracion.count();
+    cout << "Tamano: " << tam << " | Hilos: " << hilos << " | Tiempo de "
+      "ejecucion: " << duracion.count() << " ms | Aceleracion: " <<
+      tiempoBase / duracion.count() << "\n";
+  }
+  cout << "\n";
+  delete[] arreglo;
+  delete[] arregloOriginal;
+}
+
+/**
+ * Función para comparar el tiempo y la memoria temporal del ordenamiento por
+ * mezcla con los de la mezcla en sitio. Cada medición usa un ordenador nuevo
+ * para que su arena refleje solo lo que necesitó ese algoritmo.
+ */
+void compararMezclas(const vector<int>& tams, uint32_t semilla) {
+  cout << "----- Mezcla contra Mezcla en sitio -----\n\n";
+  for (int tam : tams) {
+    uint32_t* arreglo = arregloAleatorio(tam, semilla);
+    Ordenador ordenadorMezcla;
+    double tiempoMezcla = medirTiempo(ordenadorMezcla,
+      &Ordenador::ordenamientoPorMezcla, arreglo, tam);
+    Ordenador ordenadorEnSitio;
+    double tiempoEnSitio = medirTiempo(ordenadorEnSitio,
+      &Ordenador::ordenamientoPorMezclaEnSitio, arreglo, tam);
+    cout << "Tamano: " << tam << "\n";
+    cout << "Mezcla: " << tiempoMezcla << " ms | Memoria temporal: " <<
+      ordenadorMezcla.getMemoriaTemporal() << " bytes\n";
+    cout << "Mezcla en sitio: " << tiempoEnSitio << " ms | Memoria temporal: "
+      << ordenadorEnSitio.getMemoriaTemporal() +
+      Ordenador::kBufferEnSitio * sizeof(int) <<
+      " bytes (buffer fijo)\n\n";
+    delete[] arreglo;
+  }
+}
+
+/**
+ * Función para generar nombres completos aleatorios ("Apellido Apellido
+ * Nombre") a partir de listas de nombres y apellidos comunes.
+ */
+vector<string> nombresAleatorios(int tam, uint32_t semilla) {
+  const vector<string> nombres = {"Ana", "Andrea", "Carlos", "Daniel",
+    "Diana", "Fernando", "Gabriela", "Jose", "Josue", "Laura", "Luis",
+    "Maria", "Mariana", "Mario", "Pablo", "Sofia", "Valeria", "Victor"};
+  const vector<string> apellidos = {"Alvarado", "Araya", "Arias", "Campos",
+    "Castro", "Chaves", "Gonzalez", "Hernandez", "Jimenez", "Mora", "Rojas",
+    "Salazar", "Sanchez", "Solano", "Torres", "Vargas", "Vega", "Villalobos"};
+  mt19937 generador(semilla);
+  uniform_int_distribution<size_t> nombre(0, nombres.size() - 1);
+  uniform_int_distribution<size_t> apellido(0, apellidos.size() - 1);
+  vector<string> resultado(tam);
+  for (int i = 0; i < tam; ++i) {
+    resultado[i] = apellidos[apellido(generador)] + " " +
+      apellidos[apellido(generador)] + " " + nombres[nombre(generador)] +
+      " " + nombres[nombre(generador)];
+  }
+  return resultado;
+}
+
+/**
+ * Función para comparar el ordenamiento de cadenas con std::sort y con el
+ * ordenamiento por mezcla sobre la misma lista de nombres.
+ */
+void medirCadenas(Ordenador& ordenador, int tam, uint32_t semilla) {
+  vector<string> nombres = nombresAleatorios(tam, semilla);
+  cout << "----- Ordenamiento de cadenas (" << tam << " nombres) -----\n\n";
+  for (int metodo = 0; metodo < 3; ++metodo) {
+    vector<string_view> vistas(nombres.begin(), nombres.end());
+    auto inicio = chrono::high_resolution_clock::now();
+    if (metodo == 0) {
+      ordenador.ordenamientoDeCadenas(vistas.data(), tam);
+    } else if (metodo == 1) {
+      sort(vistas.begin(), vistas.end());
+    } else {
+      ordenador.ordenamientoPorMezcla(vistas.data(), tam);
+    }
+    auto fin = chrono::high_resolution_clock::now();
+    chrono::duration<double, milli> duracion = fin - inicio;
+    const char* nombre = (metodo == 0) ? "Cadenas (multillave)" :
+      (metodo == 1) ? "std::sort" : "Mezcla";
+    cout << nombre << " | Tiempo de ejecucion: " << duracion.count() <<
+      " ms\n";
+  }
+  cout << "\n";
+}
+
 int main() {
   Ordenador ordenador;
   vector<int> tams = {50000, 100000, 150000, 200000};
   vector<string> algoritmos = {"Seleccion", "Insercion", "Mezcla",
-    "Monticulos", "Rapido", "Residuos"};
+    "Monticulos", "Rapido", "Residuos", "Muestreo", "MezclaEnSitio"};
   cout << "Tiempos de ejecucion\n";
   /** Usar una semilla fija para generar los números aleatorios. */
   const uint32_t semilla = 123456;
@@ -91,6 +205,14 @@ int main() {
           tiempo = medirTiempo(ordenador, &Ordenador::ordenamientoPorRadix,
             arreglo, tam);
         }
+        if (algoritmos[i] == "Muestreo") {
+          tiempo = medirTiempo(ordenador,
+            &Ordenador::ordenamientoPorMuestreoParalelo, arreglo, tam);
+        }
+        if (algoritmos[i] == "MezclaEnSitio") {
+          tiempo = medirTiempo(ordenador,
+            &Ordenador::ordenamientoPorMezclaEnSitio, arreglo, tam);
+        }
         tiempos.push_back(tiempo);
         cout << "Tamano: " << tam << " | Tiempo de ejecucion: " << tiempo <<
           " ms\n";
@@ -103,5 +225,11 @@ int main() {
       delete[] arreglo;
     }
   }
+  /** Ordenar cadenas con nombres realistas. */
+  medirCadenas(ordenador, 1000000, semilla);
+  /** Comparar las dos variantes del ordenamiento por mezcla. */
+  compararMezclas({1000000, 10000000}, semilla);
+  /** Medir la escalabilidad con 10^8 llaves. */
+  medirEscalabilidad(ordenador, 100000000, semilla);
   return 0;
 }
@@ -0,0 +1,172 @@
+// Copyright 2024 Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "MonticuloDArio.hpp"
+
+/**
+ * Microbenchmark que compara 'MonticuloDArio' con 'std::priority_queue' en
+ * dos cargas de trabajo de colas de prioridad mínima:
+ *  - Insertar n llaves aleatorias y luego extraerlas todas.
+ *  - Una carga tipo Dijkstra: n elementos cuyas llaves se disminuyen varias
+ *    veces mientras se van extrayendo. 'std::priority_queue' no permite cambiar
+ *    llaves, así que inserta un duplicado y descarta las entradas viejas al
+ *    extraerlas, que es la forma usual de simular disminuir llave con ella.
+ *
+ * Uso: ./medicion_monticulo
+ */
+
+/** Devuelve n llaves aleatorias con la semilla dada. */
+vector<uint32_t> llavesAleatorias(int n, uint32_t semilla) {
+  mt19937 generador(semilla);
+  uniform_int_distribution<uint32_t> distribucion(0, UINT32_MAX);
+  vector<uint32_t> llaves(n);
+  for (uint32_t& llave : llaves) llave = distribucion(generador);
+  return llaves;
+}
+
+/** Mide en milisegundos el tiempo de ejecutar la función dada. */
+template <typename Funcion>
+double medir(Funcion funcion) {
+  auto inicio = chrono::high_resolution_clock::now();
+  funcion();
+  auto fin = chrono::high_resolution_clock::now();
+  chrono::duration<double, milli> duracion = fin - inicio;
+  return duracion.count();
+}
+
+/** Inserta y extrae todas las llaves con un montículo d-ario. */
+template <int D>
+uint64_t insertarYExtraerDArio(const vector<uint32_t>& llaves) {
+  int n = static_cast<int>(llaves.size());
+  MonticuloDArio<uint32_t, D> monticulo(n);
+  for (int i = 0; i < n; ++i) monticulo.insertar(i, llaves[i]);
+  uint64_t suma = 0;
+  while (!monticulo.vacio()) {
+    suma += monticulo.llaveTope();
+    monticulo.extraer();
+  }
+  return suma;
+}
+
+/** Inserta y extrae todas las llaves con std::priority_queue. */
+uint64_t insertarYExtraerEstandar(const vector<uint32_t>& llaves) {
+  priority_queue<uint32_t, vector<uint32_t>, greater<uint32_t>> cola;
+  for (uint32_t llave : llaves) cola.push(llave);
+  uint64_t suma = 0;
+  while (!cola.empty()) {
+    suma += cola.top();
+    cola.pop();
+  }
+  return suma;
+}
+
+/**
+ * Carga tipo Dijkstra con un montículo d-ario: se construye el montículo en
+ * O(n) y, por cada elemento extraído, se disminuyen las llaves de los
+ * elementos indicados en 'vecinos'.
+ */
+template <int D>
+uint64_t dijkstraDArio(const vector<uint32_t>& llaves,
+  const vector<int>& vecinos, int grado) {
+  int n = static_cast<int>(llaves.size());
+  MonticuloDArio<uint32_t, D> monticulo(n);
+  monticulo.construir(llaves.data(), n);
+  uint64_t suma = 0;
+  while (!monticulo.vacio()) {
+    int u = monticulo.tope();
+    uint32_t distancia = monticulo.llaveTope();
+    suma += distancia;
+    monticulo.extraer();
+    for (int k = 0; k < grado; ++k) {
+      int v = vecinos[static_cast<size_t>(u) * grado + k];
+      if (monticulo.contiene(v) && distancia / 2 < monticulo.llave(v)) {
+        monticulo.disminuirLlave(v, distancia / 2 + monticulo.llave(v) / 2);
+      }
+    }
+  }
+  return suma;
+}
+
+/**
+ * La misma carga con std::priority_queue: cada disminución inserta un par
+ * nuevo y las entradas que ya no corresponden a la llave actual se ignoran.
+ */
+uint64_t dijkstraEstandar(const vector<uint32_t>& llaves,
+  const vector<int>& vecinos, int grado) {
+  int n = static_cast<int>(llaves.size());
+  using Par = pair<uint32_t, int>;
+  vector<uint32_t> actual(llaves);
+  vector<bool> extraido(n, false);
+  priority_queue<Par, vector<Par>, greater<Par>> cola;
+  for (int i = 0; i < n; ++i) cola.push({llaves[i], i});
+  uint64_t suma = 0;
+  while (!cola.empty()) {
+    Par tope = cola.top();
+    cola.pop();
+    int u = tope.second;
+    if (extraido[u] || tope.first != actual[u]) continue;
+    extraido[u] = true;
+    uint32_t distancia = tope.first;
+    suma += distancia;
+    for (int k = 0; k < grado; ++k) {
+      int v = vecinos[static_cast<size_t>(u) * grado + k];
+      if (!extraido[v] && distancia / 2 < actual[v]) {
+        actual[v] = distancia / 2 + actual[v] / 2;
+        cola.push({actual[v], v});
+      }
+    }
+  }
+  return suma;
+}
+
+int main() {
+  const int n = 1000000;
+  const int grado = 8;
+  const uint32_t semilla = 2024;
+  vector<uint32_t> llaves = llavesAleatorias(n, semilla);
+  mt19937 generador(semilla + 1);
+  uniform_int_distribution<int> distribucion(0, n - 1);
+  vector<int> vecinos(static_cast<size_t>(n) * grado);
+  for (int& v : vecinos) v = distribucion(generador);
+
+  /** Las sumas se comparan para verificar que todas las colas coinciden. */
+  uint64_t suma = 0;
+  cout << "----- Insertar y extraer " << n << " llaves -----\n\n";
+  cout << "std::priority_queue: "
+    << medir([&] { suma = insertarYExtraerEstandar(llaves); }) << " ms\n";
+  uint64_t esperada = suma;
+  cout << "MonticuloDArio<2>:   "
+    << medir([&] { suma = insertarYExtraerDArio<2>(llaves); }) << " ms"
+    << (suma == esperada ? "" : " (resultado distinto)") << "\n";
+  cout << "MonticuloDArio<4>:   "
+    << medir([&] { suma = insertarYExtraerDArio<4>(llaves); }) << " ms"
+    << (suma == esperada ? "" : " (resultado distinto)") << "\n";
+  cout << "MonticuloDArio<8>:   "
+    << medir([&] { suma = insertarYExtraerDArio<8>(llaves); }) << " ms"
+    << (suma == esperada ? "" : " (resultado distinto)") << "\n\n";
+
+  cout << "----- Carga tipo Dijkstra con " << n << " elementos y " << grado
+    << " vecinos -----\n\n";
+  cout << "std::priority_queue: "
+    << medir([&] { suma = dijkstraEstandar(llaves, vecinos, grado); })
+    << " ms\n";
+  esperada = suma;
+  cout << "MonticuloDArio<2>:   "
+    << medir([&] { suma = dijkstraDArio<2>(llaves, vecinos, grado); })
+    << " ms" << (suma == esperada ? "" : " (resultado distinto)") << "\n";
+  cout << "MonticuloDArio<4>:   "
+    << medir([&] { suma = dijkstraDArio<4>(llaves, vecinos, grado); })
+    << " ms" << (suma == esperada ? "" : " (resultado distinto)") << "\n";
+  cout << "MonticuloDArio<8>:   "
+    << medir([&] { suma = dijkstraDArio<8>(llaves, vecinos, grado); })
+    << " ms" << (suma == esperada ? "" : " (resultado distinto)") << "\n";
+  return 0;
+}
@@ -0,0 +1,177 @@
+// Copyright 2024 Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <string>
+
+#include "Ordenador.hpp"
+
+/**
+ * Herramienta que ordena en su lugar un archivo binario de llaves utilizando
+ * cualquiera de los algoritmos de 'Ordenador'. El archivo se proyecta en
+ * memoria con mmap, por lo que no se hace ninguna copia intermedia: el
+ * algoritmo trabaja directamente sobre las páginas del archivo.
+ *
+ * Uso: ./ordenar_archivo <archivo> <u32|u64|i32> <algoritmo>
+ */
+
+/** Muestra las instrucciones de uso del programa. */
+void mostrarUso(const char* programa) {
+  cerr << "Uso: " << programa << " <archivo> <u32|u64|i32> <algoritmo>\n"
+    << "Algoritmos: Seleccion, Insercion, Mezcla, Monticulos, Rapido, "
+    "Residuos, Muestreo, MezclaEnSitio\n";
+}
+
+/** Método de 'Ordenador' que ordena un arreglo de llaves de tipo T. */
+template <typename T>
+using Metodo = void (Ordenador::*)(T*, int) const;
+
+/**
+ * @brief Obtiene los algoritmos disponibles según su nombre.
+ *
+ * @return Mapa del nombre de cada algoritmo a su método; los nombres son los
+ * mismos para todos los tipos de llave.
+ */
+template <typename T>
+const map<string, Metodo<T>>& metodosDisponibles() {
+  static const map<string, Metodo<T>> metodos = {
+    {"Seleccion", &Ordenador::ordenamientoPorSeleccion},
+    {"Insercion", &Ordenador::ordenamientoPorInsercion},
+    {"Mezcla", &Ordenador::ordenamientoPorMezcla},
+    {"MezclaEnSitio", &Ordenador::ordenamientoPorMezclaEnSitio},
+    {"Monticulos", &Ordenador::ordenamientoPorMonticulos},
+    {"Rapido", &Ordenador::ordenamientoRapido},
+    {"Residuos", &Ordenador::ordenamientoPorRadix},
+    {"Muestreo", &Ordenador::ordenamientoPorMuestreoParalelo},
+  };
+  return metodos;
+}
+
+/**
+ * @brief Ordena las llaves proyectadas en memoria con el algoritmo indicado.
+ *
+ * @param datos Inicio de la región proyectada.
+ * @param n Cantidad de llaves en la región.
+ * @param algoritmo Nombre del algoritmo a utilizar; debe ser uno de los de
+ * metodosDisponibles().
+ * @return Tiempo de ordenamiento en segundos.
+ */
+template <typename T>
+double ordenarProyeccion(T* datos, int n, const string& algoritmo) {
+  Metodo<T> metodo = metodosDisponibles<T>().at(algoritmo);
+  Ordenador ordenador;
+  auto inicio = chrono::high_resolution_clock::now();
+  (ordenador.*metodo)(datos, n);
+  auto fin = chrono::high_resolution_clock::now();
+  chrono::duration<double> duracion = fin - inicio;
+  return duracion.count();
+}
+
+int main(int argc, char* argv[]) {
+  if (argc != 4) {
+    mostrarUso(argv[0]);
+    return 1;
+  }
+  const string ruta = argv[1];
+  const string tipo = argv[2];
+  const string algoritmo = argv[3];
+
+  size_t tamLlave = 0;
+  if (tipo == "u32" || tipo == "i32") {
+    tamLlave = 4;
+  } else if (tipo == "u64") {
+    tamLlave = 8;
+  } else {
+    cerr << "Error: Tipo de llave desconocido: " << tipo << "\n";
+    mostrarUso(argv[0]);
+    return 1;
+  }
+  /** Validar el algoritmo antes de abrir y proyectar el archivo. */
+  if (metodosDisponibles<uint32_t>().count(algoritmo) == 0) {
+    cerr << "Error: Algoritmo desconocido: " << algoritmo << "\n";
+    mostrarUso(argv[0]);
+    return 1;
+  }
+
+  int descriptor = open(ruta.c_str(), O_RDWR);
+  if (descriptor < 0) {
+    cerr << "Error: No se pudo abrir el archivo " << ruta << ": "
+      << strerror(errno) << "\n";
+    return 1;
+  }
+  struct stat info;
+  if (fstat(descriptor, &info) != 0) {
+    cerr << "Error: No se pudo consultar el tamano del archivo: "
+      << strerror(errno) << "\n";
+    close(descriptor);
+    return 1;
+  }
+  size_t bytes = static_cast<size_t>(info.st_size);
+  if (bytes % tamLlave != 0) {
+    cerr << "Error: El tamano del archivo no es multiplo de " << tamLlave
+      << " bytes.\n";
+    close(descriptor);
+    return 1;
+  }
+  size_t cantidad = bytes / tamLlave;
+  if (cantidad > static_cast<size_t>(INT_MAX)) {
+    cerr << "Error: El archivo tiene mas de " << INT_MAX << " llaves.\n";
+    close(descriptor);
+    return 1;
+  }
+  if (cantidad == 0) {
+    cout << "El archivo esta vacio, no hay nada que ordenar.\n";
+    close(descriptor);
+    return 0;
+  }
+
+  /** Proyectar el archivo completo; los cambios se escriben en el archivo. */
+  void* region = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+    descriptor, 0);
+  if (region == MAP_FAILED) {
+    cerr << "Error: No se pudo proyectar el archivo en memoria: "
+      << strerror(errno) << "\n";
+    close(descriptor);
+    return 1;
+  }
+  /**
+   * Montículos salta por todo el arreglo, el resto de algoritmos lo recorre
+   * de forma secuencial. En ambos casos se pide cargar las páginas de una vez.
+   */
+  madvise(region, bytes, algoritmo == "Monticulos" ? MADV_RANDOM :
+    MADV_SEQUENTIAL);
+  madvise(region, bytes, MADV_WILLNEED);
+
+  int n = static_cast<int>(cantidad);
+  double segundos = 0.0;
+  if (tipo == "u32") {
+    segundos = ordenarProyeccion(static_cast<uint32_t*>(region), n, algoritmo);
+  } else if (tipo == "i32") {
+    segundos = ordenarProyeccion(static_cast<int32_t*>(region), n, algoritmo);
+  } else {
+    segundos = ordenarProyeccion(static_cast<uint64_t*>(region), n, algoritmo);
+  }
+
+  /**
+   * Asegurar que el resultado quede escrito en el archivo; si no se pudo, el
+   * archivo no quedó ordenado y no se informa el rendimiento.
+   */
+  int codigo = 0;
+  if (msync(region, bytes, MS_SYNC) != 0) {
+    cerr << "Error: No se pudo sincronizar el archivo: " << strerror(errno)
+      << "\n";
+    codigo = 1;
+  } else {
+    cout << "Llaves ordenadas: " << n << " | Tiempo: " << segundos * 1000.0
+      << " ms | Rendimiento: " << (bytes / 1e9) / segundos << " GB/s\n";
+  }
+  munmap(region, bytes);
+  close(descriptor);
+  return codigo;
+}
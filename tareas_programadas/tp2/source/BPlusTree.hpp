@@ -0,0 +1,438 @@
+/*
+ * Credits
+ * Based on: Prof. Arturo Camacho, Universidad de Costa Rica
+ * Template provided by: Prof. Allan Berrocal Rojas
+ * Adapted by: Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+ */
+
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+#include "NodePool.hpp"
+
+/**
+ * @class BPlusTree
+ * @brief Implements an ordered set as a B+ tree, with the same insert,
+ * search and remove operations as RBTree.
+ * @tparam DataType Type of data stored in the tree.
+ * @tparam NodeBytes Bytes of keys per node; the default of 256 (four cache
+ * lines) gives 64 keys per node for int.
+ * @tparam Allocator Allocator of the nodes (see NodePool.hpp).
+ * @details Keys live only in the leaves, which are linked from left to right
+ * for range scans; inner nodes hold separators, where keys[i] is not greater
+ * than any key of children[i + 1] and greater than every key of children[i].
+ * A lookup in a million keys visits 4 nodes instead of the ~40 of a red-black
+ * tree, and each node is searched by counting the keys below the value over
+ * all its slots, without branches, which the compiler vectorizes. Insertions
+ * split full nodes and removals refill nodes at the minimum on the way down,
+ * so neither has to walk back up.
+ */
+template <typename DataType, size_t NodeBytes = 256,
+  template <typename> class Allocator = NodePool>
+class BPlusTree {
+ public:
+  /** Maximum number of keys per node. */
+  static constexpr size_t kKeys =
+    NodeBytes / sizeof(DataType) < 4 ? 4 : NodeBytes / sizeof(DataType);
+
+  /** Constructor. */
+  BPlusTree() = default;
+
+  /** Destructor. */
+  ~BPlusTree() {
+    clear();
+  }
+
+  /** The nodes belong to the tree's allocators, so it cannot be copied. */
+  BPlusTree(const BPlusTree &) = delete;
+  BPlusTree &operator=(const BPlusTree &) = delete;
+
+  /**
+   * @brief Inserts a value into the tree.
+   * @param value The value to insert.
+   * @note Duplicates are not allowed; if the value already exists, the tree
+   * is not changed.
+   */
+  void insert(const DataType &value) {
+    if (root == nullptr) root = leaves.create();
+    if (isFull(root)) {
+      /** Split the root, which is the only way the tree grows in height. */
+      Inner *newRoot = inners.create();
+      newRoot->children[0] = root;
+      splitChild(newRoot, 0, height);
+      root = newRoot;
+      ++height;
+    }
+    Node *node = root;
+    for (size_t level = height; level > 0; --level) {
+      Inner *inner = static_cast<Inner *>(node);
+      size_t index = upperBound(inner, value);
+      if (isFull(inner->children[index])) {
+        splitChild(inner, index, level - 1);
+        if (!(value < inner->keys[index])) ++index;
+      }
+      node = inner->children[index];
+    }
+    Leaf *leaf = static_cast<Leaf *>(node);
+    size_t index = lowerBound(leaf, value);
+    if (index < leaf->count && leaf->keys[index] == value) return;
+    for (size_t i = leaf->count; i > index; --i) {
+      leaf->keys[i] = leaf->keys[i - 1];
+    }
+    leaf->keys[index] = value;
+    ++leaf->count;
+    ++size;
+  }
+
+  /**
+   * @brief Searches for a value in the tree.
+   * @param value The value to search for.
+   * @return Pointer to the stored value, or nullptr if not found.
+   */
+  const DataType *search(const DataType &value) const {
+    if (root == nullptr) return nullptr;
+    const Leaf *leaf = findLeaf(value);
+    size_t index = lowerBound(leaf, value);
+    if (index < leaf->count && leaf->keys[index] == value) {
+      return &leaf->keys[index];
+    }
+    return nullptr;  /** Value not found. */
+  }
+
+  /**
+   * @brief Removes a value from the tree, if it exists.
+   * @param value The value to remove.
+   */
+  void remove(const DataType &value) {
+    if (root == nullptr) return;
+    Node *node = root;
+    for (size_t level = height; level > 0; --level) {
+      Inner *inner = static_cast<Inner *>(node);
+      size_t index = upperBound(inner, value);
+      if (inner->children[index]->count <= kMinKeys) {
+        index = refillChild(inner, index, level - 1);
+      }
+      node = inner->children[index];
+      if (inner == root && inner->count == 0) {
+        /** The root lost its last separator; its only child replaces it. */
+        root = node;
+        --height;
+        inners.destroy(inner);
+      }
+    }
+    Leaf *leaf = static_cast<Leaf *>(node);
+    size_t index = lowerBound(leaf, value);
+    if (index == leaf->count || !(leaf->keys[index] == value)) return;
+    for (size_t i = index + 1; i < leaf->count; ++i) {
+      leaf->keys[i - 1] = leaf->keys[i];
+    }
+    --leaf->count;
+    --size;
+    if (leaf->count == 0 && leaf == root) {
+      leaves.destroy(leaf);
+      root = nullptr;
+    }
+  }
+
+  /**
+   * @brief Visits, in ascending order, every key in the range [low, high].
+   * @param low The smallest key to visit.
+   * @param high The largest key to visit.
+   * @param visit Function called with each key.
+   */
+  template <typename Visitor>
+  void range(const DataType &low, const DataType &high, Visitor visit) const {
+    if (root == nullptr) return;
+    const Leaf *leaf = findLeaf(low);
+    size_t index = lowerBound(leaf, low);
+    while (leaf != nullptr) {
+      for (; index < leaf->count; ++index) {
+        if (high < leaf->keys[index]) return;
+        visit(leaf->keys[index]);
+      }
+      leaf = leaf->next;
+      index = 0;
+    }
+  }
+
+  /**
+   * @brief Retrieves the number of keys in the tree.
+   * @return The number of keys.
+   */
+  size_t getSize() const {
+    return size;
+  }
+
+  /**
+   * @brief Retrieves the height of the tree.
+   * @return The number of inner levels above the leaves.
+   */
+  size_t getHeight() const {
+    return height;
+  }
+
+ private:
+  /** Minimum number of keys of a node other than the root. */
+  static constexpr size_t kMinKeys = kKeys / 2 - 1;
+
+  /** Data shared by leaves and inner nodes. */
+  struct Node {
+    DataType keys[kKeys]{};  /** Keys; only the first count are in use. */
+    size_t count = 0;  /** Number of keys in the node. */
+  };
+
+  /** A leaf, holding keys of the set. */
+  struct alignas(64) Leaf : Node {
+    Leaf *next = nullptr;  /** Leaf to the right, for range scans. */
+  };
+
+  /** An inner node, holding count separators and count + 1 children. */
+  struct alignas(64) Inner : Node {
+    Node *children[kKeys + 1]{};  /** Leaves if the level above them is 1. */
+  };
+
+  Node *root = nullptr;  /** Root of the tree; a leaf while height is 0. */
+  size_t height = 0;  /** Number of inner levels. */
+  size_t size = 0;  /** Number of keys in the tree. */
+  Allocator<Leaf> leaves;  /** Allocator of the leaves. */
+  Allocator<Inner> inners;  /** Allocator of the inner nodes. */
+
+  /**
+   * @brief Counts the keys of a node that come before a value.
+   * @tparam Inclusive Whether keys equal to the value are also counted.
+   * @return The number of keys less than (or not greater than) the value.
+   * @details Every slot is compared and unused ones are masked, so the loop
+   * has a constant trip count and no branches.
+   */
+  template <bool Inclusive>
+  static size_t rank(const Node *node, const DataType &value) {
+    const unsigned count = static_cast<unsigned>(node->count);
+    unsigned rank = 0;
+    for (unsigned i = 0; i < kKeys; ++i) {
+      bool before = Inclusive ? !(value < node->keys[i])
+        : node->keys[i] < value;
+      rank += static_cast<unsigned>(before) & static_cast<unsigned>(i < count);
+    }
+    return rank;
+  }
+
+  /** Index of the first key not less than a value. */
+  static size_t lowerBound(const Node *node, const DataType &value) {
+    return rank<false>(node, value);
+  }
+
+  /** Index of the child of an inner node whose range holds a value. */
+  static size_t upperBound(const Node *node, const DataType &value) {
+    return rank<true>(node, value);
+  }
+
+  /** Descends from the root to the leaf whose range holds a value. */
+  const Leaf *findLeaf(const DataType &value) const {
+    const Node *node = root;
+    for (size_t level = height; level > 0; --level) {
+      const Inner *inner = static_cast<const Inner *>(node);
+      node = inner->children[upperBound(inner, value)];
+    }
+    return static_cast<const Leaf *>(node);
+  }
+
+  /** Whether a node has no room for another key. */
+  static bool isFull(const Node *node) {
+    return node->count == kKeys;
+  }
+
+  /**
+   * @brief Splits a full child in two halves and adds the right half to its
+   * parent, which must not be full.
+   * @param parent The parent of the child.
+   * @param index The position of the child in the parent.
+   * @param level The level of the child; 0 for a leaf.
+   */
+  void splitChild(Inner *parent, size_t index, size_t level) {
+    Node *child = parent->children[index];
+    Node *right;
+    DataType separator;
+    if (level == 0) {
+      /** Leaves keep every key, so the separator is copied up. */
+      Leaf *leaf = static_cast<Leaf *>(child);
+      Leaf *sibling = leaves.create();
+      size_t half = kKeys / 2;
+      for (size_t i = half; i < kKeys; ++i) {
+        sibling->keys[i - half] = leaf->keys[i];
+      }
+      sibling->count = kKeys - half;
+      leaf->count = half;
+      sibling->next = leaf->next;
+      leaf->next = sibling;
+      separator = sibling->keys[0];
+      right = sibling;
+    } else {
+      /** The middle separator moves up to the parent. */
+      Inner *inner = static_cast<Inner *>(child);
+      Inner *sibling = inners.create();
+      size_t middle = kKeys / 2;
+      for (size_t i = middle + 1; i < kKeys; ++i) {
+        sibling->keys[i - middle - 1] = inner->keys[i];
+        sibling->children[i - middle - 1] = inner->children[i];
+      }
+      sibling->children[kKeys - middle - 1] = inner->children[kKeys];
+      sibling->count = kKeys - middle - 1;
+      inner->count = middle;
+      separator = inner->keys[middle];
+      right = sibling;
+    }
+    for (size_t i = parent->count; i > index; --i) {
+      parent->keys[i] = parent->keys[i - 1];
+      parent->children[i + 1] = parent->children[i];
+    }
+    parent->keys[index] = separator;
+    parent->children[index + 1] = right;
+    ++parent->count;
+  }
+
+  /**
+   * @brief Gives a child at the minimum one more key, borrowing it from a
+   * sibling or merging the child with a sibling.
+   * @param parent The parent of the child.
+   * @param index The position of the child in the parent.
+   * @param level The level of the child; 0 for a leaf.
+   * @return The position in the parent of the node that now covers the range
+   * of the child.
+   */
+  size_t refillChild(Inner *parent, size_t index, size_t level) {
+    if (index > 0 && parent->children[index - 1]->count > kMinKeys) {
+      borrowFromLeft(parent, index, level);
+      return index;
+    }
+    if (index < parent->count &&
+      parent->children[index + 1]->count > kMinKeys) {
+      borrowFromRight(parent, index, level);
+      return index;
+    }
+    if (index < parent->count) {
+      merge(parent, index, level);
+      return index;
+    }
+    merge(parent, index - 1, level);
+    return index - 1;
+  }
+
+  /** Moves the last key of the left sibling of a child to the child. */
+  void borrowFromLeft(Inner *parent, size_t index, size_t level) {
+    Node *child = parent->children[index];
+    Node *left = parent->children[index - 1];
+    for (size_t i = child->count; i > 0; --i) {
+      child->keys[i] = child->keys[i - 1];
+    }
+    if (level == 0) {
+      child->keys[0] = left->keys[left->count - 1];
+      parent->keys[index - 1] = child->keys[0];
+    } else {
+      Inner *inner = static_cast<Inner *>(child);
+      Inner *sibling = static_cast<Inner *>(left);
+      for (size_t i = inner->count + 1; i > 0; --i) {
+        inner->children[i] = inner->children[i - 1];
+      }
+      inner->keys[0] = parent->keys[index - 1];
+      inner->children[0] = sibling->children[sibling->count];
+      parent->keys[index - 1] = sibling->keys[sibling->count - 1];
+    }
+    ++child->count;
+    --left->count;
+  }
+
+  /** Moves the first key of the right sibling of a child to the child. */
+  void borrowFromRight(Inner *parent, size_t index, size_t level) {
+    Node *child = parent->children[index];
+    Node *right = parent->children[index + 1];
+    if (level == 0) {
+      child->keys[child->count] = right->keys[0];
+      for (size_t i = 1; i < right->count; ++i) {
+        right->keys[i - 1] = right->keys[i];
+      }
+      parent->keys[index] = right->keys[0];
+    } else {
+      Inner *inner = static_cast<Inner *>(child);
+      Inner *sibling = static_cast<Inner *>(right);
+      inner->keys[inner->count] = parent->keys[index];
+      inner->children[inner->count + 1] = sibling->children[0];
+      parent->keys[index] = sibling->keys[0];
+      for (size_t i = 1; i < sibling->count; ++i) {
+        sibling->keys[i - 1] = sibling->keys[i];
+      }
+      for (size_t i = 1; i <= sibling->count; ++i) {
+        sibling->children[i - 1] = sibling->children[i];
+      }
+    }
+    ++child->count;
+    --right->count;
+  }
+
+  /**
+   * @brief Merges the child at a position with its right sibling, removing
+   * the separator between them from the parent.
+   */
+  void merge(Inner *parent, size_t index, size_t level) {
+    Node *left = parent->children[index];
+    Node *right = parent->children[index + 1];
+    if (level == 0) {
+      Leaf *leaf = static_cast<Leaf *>(left);
+      Leaf *sibling = static_cast<Leaf *>(right);
+      for (size_t i = 0; i < sibling->count; ++i) {
+        leaf->keys[leaf->count + i] = sibling->keys[i];
+      }
+      leaf->count += sibling->count;
+      leaf->next = sibling->next;
+      leaves.destroy(sibling);
+    } else {
+      /** The separator comes down between the keys of both nodes. */
+      Inner *inner = static_cast<Inner *>(left);
+      Inner *sibling = static_cast<Inner *>(right);
+      inner->keys[inner->count] = parent->keys[index];
+      for (size_t i = 0; i < sibling->count; ++i) {
+        inner->keys[inner->count + 1 + i] = sibling->keys[i];
+      }
+      for (size_t i = 0; i <= sibling->count; ++i) {
+        inner->children[inner->count + 1 + i] = sibling->children[i];
+      }
+      inner->count += sibling->count + 1;
+      inners.destroy(sibling);
+    }
+    for (size_t i = index + 1; i < parent->count; ++i) {
+      parent->keys[i - 1] = parent->keys[i];
+      parent->children[i] = parent->children[i + 1];
+    }
+    --parent->count;
+  }
+
+  /** Removes all nodes from the tree. */
+  void clear() {
+    if constexpr (!Allocator<Leaf>::kBulkRelease ||
+      !std::is_trivially_destructible_v<DataType>) {
+      if (root != nullptr) destroyTree(root, height);
+    }
+    leaves.release();
+    inners.release();
+    root = nullptr;
+    height = 0;
+    size = 0;
+  }
+
+  /**
+   * @brief Recursive function to destroy the nodes of a subtree.
+   * @param node Root of the subtree.
+   * @param level Level of the node; 0 for a leaf.
+   */
+  void destroyTree(Node *node, size_t level) {
+    if (level == 0) {
+      leaves.destroy(static_cast<Leaf *>(node));
+      return;
+    }
+    Inner *inner = static_cast<Inner *>(node);
+    for (size_t i = 0; i <= inner->count; ++i) {
+      destroyTree(inner->children[i], level - 1);
+    }
+    inners.destroy(inner);
+  }
+};
@@ -8,9 +8,15 @@
 #pragma once
 #include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <stack>
+#include <type_traits>
+#include <utility>
 
-template <typename DataType>
+#include "KeyValuePair.hpp"
+#include "NodePool.hpp"
+
+template <typename DataType, template <typename> class Allocator>
 class BSTree;
 
 /**
@@ -22,7 +28,8 @@ class BSTree;
 template <typename DataType>
 class BSTreeNode {
  public:
-  friend class BSTree<DataType>;
+  template <typename, template <typename> class>
+  friend class BSTree;
 
   /** 
    * @brief Default constructor that initializes an empty node with all 
@@ -47,22 +54,49 @@ class BSTreeNode {
     this->right = right;
   }
 
+  /**
+   * @brief Constructs a node whose key is built in place, without links.
+   * @param args The arguments of the key's constructor.
+   */
+  template <typename... Args>
+  explicit BSTreeNode(std::in_place_t, Args &&...args)
+    : key(std::forward<Args>(args)...) {}
+
   /** Destructor. */
   ~BSTreeNode() {}
 
   /**
    * @brief Retrieves the key stored in the node.
-   * @return The key value.
+   * @return Reference to the key value.
    */
-  DataType getKey() const {
+  const DataType &getKey() const {
     return key;
   }
 
+  /**
+   * @brief Retrieves the mapped value, in a node of a map (see
+   * KeyValuePair.hpp).
+   * @return Reference to the value, which can be modified in place.
+   */
+  auto &getValue() {
+    return key.value;
+  }
+
+  /** Retrieves the mapped value of a read-only node. */
+  const auto &getValue() const {
+    return key.value;
+  }
+
   /**
    * @brief Retrieves the parent node.
    * @return Pointer to the parent node.
    */
-  BSTreeNode<DataType> *getParent() const {
+  BSTreeNode<DataType> *getParent() {
+    return parent;
+  }
+
+  /** Retrieves the parent of a read-only node, also read-only. */
+  const BSTreeNode<DataType> *getParent() const {
     return parent;
   }
 
@@ -70,7 +104,12 @@ class BSTreeNode {
    * @brief Retrieves the left child node.
    * @return Pointer to the left child node.
    */
-  BSTreeNode<DataType> *getLeft() const {
+  BSTreeNode<DataType> *getLeft() {
+    return left;
+  }
+
+  /** Retrieves the left child of a read-only node, also read-only. */
+  const BSTreeNode<DataType> *getLeft() const {
     return left;
   }
 
@@ -78,7 +117,12 @@ class BSTreeNode {
    * @brief Retrieves the right child node.
    * @return Pointer to the right child node.
    */
-  BSTreeNode<DataType> *getRight() const {
+  BSTreeNode<DataType> *getRight() {
+    return right;
+  }
+
+  /** Retrieves the right child of a read-only node, also read-only. */
+  const BSTreeNode<DataType> *getRight() const {
     return right;
   }
 
@@ -118,10 +162,95 @@ class BSTreeNode {
  * insertion, searching, deletion and traversal.
  *
  * @tparam DataType Type of data stored in the tree.
+ * @tparam Allocator Allocator of the nodes (see NodePool.hpp); by default
+ * nodes come from a pool owned by the tree.
  */
-template <typename DataType>
+template <typename DataType, template <typename> class Allocator = NodePool>
 class BSTree {
  public:
+  /**
+   * @brief Bidirectional iterator over the keys of the tree in ascending
+   * order.
+   *
+   * @details Moves through parent pointers, so it needs no stack; a whole
+   * traversal follows each edge twice. The end of the tree is nullptr. Keys
+   * cannot be modified through the iterator, because that would break the
+   * order of the tree.
+   */
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = DataType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const DataType *;
+    using reference = const DataType &;
+
+    /** Default constructor; the iterator points to no tree. */
+    Iterator() = default;
+
+    reference operator*() const {
+      return node->key;
+    }
+
+    pointer operator->() const {
+      return &node->key;
+    }
+
+    /** Moves to the next key. */
+    Iterator &operator++() {
+      node = tree->getSuccessor(node);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    /** Moves to the previous key; from the end, to the largest key. */
+    Iterator &operator--() {
+      if (node == nullptr) {
+        node = tree->getMaximum(tree->root);
+      } else {
+        node = tree->getPredecessor(node);
+      }
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator previous = *this;
+      --*this;
+      return previous;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return node == other.node;
+    }
+
+    bool operator!=(const Iterator &other) const {
+      return node != other.node;
+    }
+
+    /**
+     * @brief Retrieves the node the iterator points to.
+     *
+     * @return Pointer to the node, or nullptr at the end.
+     */
+    const BSTreeNode<DataType> *getNode() const {
+      return node;
+    }
+
+   private:
+    friend class BSTree;
+
+    Iterator(const BSTree *tree, const BSTreeNode<DataType> *node)
+      : tree(tree), node(node) {}
+
+    const BSTree *tree = nullptr;  /** Tree being traversed. */
+    const BSTreeNode<DataType> *node = nullptr;  /** Current node. */
+  };
+
   /** Constructor. */
   BSTree() {
     root = nullptr;
@@ -139,40 +268,94 @@ class BSTree {
    * @note Duplicated values are ignored.
    */
   void insert(const DataType &value) {
-    BSTreeNode<DataType> *newNode = new BSTreeNode<DataType>(value);
+    try_emplace(value);
+  }
+
+  /**
+   * @brief Inserts a new value into the tree, moving it into the node.
+   *
+   * @param value The value to be inserted into the tree.
+   * @note Duplicated values are ignored.
+   */
+  void insert(DataType &&value) {
+    try_emplace(std::move(value));
+  }
+
+  /**
+   * @brief Inserts a value built in place from its constructor's arguments.
+   *
+   * @details The value is built before the descent, to compare it, and then
+   * moved into the node.
+   * @param args The arguments of the value's constructor.
+   * @return The node with the value, and whether it was inserted.
+   */
+  template <typename... Args>
+  std::pair<BSTreeNode<DataType> *, bool> emplace(Args &&...args) {
+    return try_emplace(DataType(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Inserts a value built in place from a key and the arguments of
+   * the mapped value, unless the key is already in the tree.
+   *
+   * @param key The key, or a whole value; it is only copied or moved if it
+   * is inserted.
+   * @param args The arguments of the mapped value's constructor.
+   * @return The node with the key, and whether it was inserted.
+   */
+  template <typename Key, typename... Args>
+  std::pair<BSTreeNode<DataType> *, bool> try_emplace(Key &&key,
+    Args &&...args) {
     BSTreeNode<DataType> *y = nullptr;
     BSTreeNode<DataType> *x = root;
     while (x != nullptr) {
       y = x;
-      if (value < x->getKey()) {
+      if (key < x->getKey()) {
         x = x->getLeft();
-      } else if (value > x->getKey()) {
+      } else if (key > x->getKey()) {
         x = x->getRight();
       } else {
         /** Duplicated value. */
-        delete newNode;
-        return;
+        return {x, false};
       }
     }
+    BSTreeNode<DataType> *newNode = allocator.create(std::in_place,
+      std::forward<Key>(key), std::forward<Args>(args)...);
     newNode->setParent(y);
     if (y == nullptr) {
       root = newNode;  /** The tree was empty. */
-    } else if (value < y->getKey()) {
+    } else if (newNode->getKey() < y->getKey()) {
       y->setLeft(newNode);
     } else {
       y->setRight(newNode);
     }
+    return {newNode, true};
   }
 
   /**
    * @brief Searches for a value within the subtree rooted at the given node.
    *
    * @param rootOfSubtree The subtree root node where the search starts.
-   * @param value The value to search for.
+   * @param value The value to search for; a bare key in a map.
    * @return Pointer to the node containing the value, or nullptr if not found.
    */
+  template <typename Key>
   BSTreeNode<DataType> *search(const BSTreeNode<DataType> *rootOfSubtree,
-    const DataType &value) const {
+    const Key &value) {
+    return const_cast<BSTreeNode<DataType> *>(std::as_const(*this).search(
+      rootOfSubtree, value));
+  }
+
+  /**
+   * @brief Searches a read-only tree, whose values cannot be modified.
+   *
+   * @param rootOfSubtree The subtree root node where the search starts.
+   * @param value The value to search for; a bare key in a map.
+   * @return Pointer to the node containing the value, or nullptr if not found.
+   */
+  template <typename Key>
+  const BSTreeNode<DataType> *search(const BSTreeNode<DataType> *rootOfSubtree,
+    const Key &value) const {
     while (rootOfSubtree != nullptr && value != rootOfSubtree->getKey()) {
       if (value < rootOfSubtree->getKey()) {
         rootOfSubtree = rootOfSubtree->getLeft();
@@ -180,7 +363,55 @@ class BSTree {
         rootOfSubtree = rootOfSubtree->getRight();
       }
     }
-    return const_cast<BSTreeNode<DataType> *>(rootOfSubtree);
+    return rootOfSubtree;
+  }
+
+  /**
+   * @brief Searches for many values, interleaving their lookups to overlap
+   * their cache misses.
+   *
+   * @details Up to kBatchWidth lookups descend the tree at the same time. Each
+   * step compares one value with a node that a previous step prefetched,
+   * prefetches the child and moves on to another lookup, so the misses of
+   * different lookups wait for memory at the same time instead of one after
+   * the other.
+   * @param keys The values to search for.
+   * @param n The number of values.
+   * @param results Receives, for each value, its node or nullptr.
+   */
+  void searchBatch(const DataType *keys, size_t n,
+    const BSTreeNode<DataType> **results) const {
+    /** Node each lookup reads next. */
+    const BSTreeNode<DataType> *nodes[kBatchWidth];
+    size_t indexes[kBatchWidth];  /** Position of each lookup in keys. */
+    size_t active = 0;
+    size_t next = 0;
+    for (; active < kBatchWidth && next < n; ++active, ++next) {
+      nodes[active] = root;
+      indexes[active] = next;
+    }
+    while (active > 0) {
+      for (size_t slot = 0; slot < active;) {
+        const BSTreeNode<DataType> *node = nodes[slot];
+        const DataType &value = keys[indexes[slot]];
+        if (node != nullptr && !(node->key == value)) {
+          node = value < node->key ? node->getLeft() : node->getRight();
+          __builtin_prefetch(node);
+          nodes[slot++] = node;
+          continue;
+        }
+        results[indexes[slot]] = node;
+        if (next < n) {
+          nodes[slot] = root;
+          indexes[slot++] = next++;
+        } else {
+          /** Fill the slot with the last lookup in flight. */
+          --active;
+          nodes[slot] = nodes[active];
+          indexes[slot] = indexes[active];
+        }
+      }
+    }
   }
 
   /**
@@ -190,11 +421,18 @@ class BSTree {
    * @return Pointer to the node with the maximum value, or nullptr if the
    * subtree is empty.
    */
-  BSTreeNode<DataType> *getMaximum(const BSTreeNode<DataType> *node) const {
+  const BSTreeNode<DataType> *getMaximum(const BSTreeNode<DataType> *node)
+    const {
     while (node && node->getRight() != nullptr) {
       node = node->getRight();
     }
-    return const_cast<BSTreeNode<DataType> *>(node);
+    return node;
+  }
+
+  /** Finds the maximum of a subtree of a tree that can be modified. */
+  BSTreeNode<DataType> *getMaximum(const BSTreeNode<DataType> *node) {
+    return const_cast<BSTreeNode<DataType> *>(
+      std::as_const(*this).getMaximum(node));
   }
 
   /**
@@ -204,11 +442,18 @@ class BSTree {
    * @return Pointer to the node with the minimum value, or nullptr if the
    * subtree is empty.
    */
-  BSTreeNode<DataType> *getMinimum(const BSTreeNode<DataType> *node) const {
+  const BSTreeNode<DataType> *getMinimum(const BSTreeNode<DataType> *node)
+    const {
     while (node && node->getLeft() != nullptr) {
       node = node->getLeft();
     }
-    return const_cast<BSTreeNode<DataType> *>(node);
+    return node;
+  }
+
+  /** Finds the minimum of a subtree of a tree that can be modified. */
+  BSTreeNode<DataType> *getMinimum(const BSTreeNode<DataType> *node) {
+    return const_cast<BSTreeNode<DataType> *>(
+      std::as_const(*this).getMinimum(node));
   }
 
   /**
@@ -217,11 +462,12 @@ class BSTree {
    * @param node The node whose successor is to be found.
    * @return Pointer to the successor node, or nullptr if no successor exists.
    */
-  BSTreeNode<DataType> *getSuccessor(const BSTreeNode<DataType> *node) const {
+  const BSTreeNode<DataType> *getSuccessor(const BSTreeNode<DataType> *node)
+    const {
     if (node->getRight() != nullptr) {
       return getMinimum(node->getRight());
     }
-    BSTreeNode<DataType> *parent = node->getParent();
+    const BSTreeNode<DataType> *parent = node->getParent();
     while (parent != nullptr && node == parent->getRight()) {
       node = parent;
       parent = parent->getParent();
@@ -229,14 +475,112 @@ class BSTree {
     return parent;
   }
 
+  /** Finds the successor of a node of a tree that can be modified. */
+  BSTreeNode<DataType> *getSuccessor(const BSTreeNode<DataType> *node) {
+    return const_cast<BSTreeNode<DataType> *>(
+      std::as_const(*this).getSuccessor(node));
+  }
+
+  /**
+   * @brief Finds the predecessor of the given node.
+   *
+   * @param node The node whose predecessor is to be found.
+   * @return Pointer to the predecessor node, or nullptr if no predecessor
+   * exists.
+   */
+  const BSTreeNode<DataType> *getPredecessor(const BSTreeNode<DataType> *node)
+    const {
+    if (node->getLeft() != nullptr) {
+      return getMaximum(node->getLeft());
+    }
+    const BSTreeNode<DataType> *parent = node->getParent();
+    while (parent != nullptr && node == parent->getLeft()) {
+      node = parent;
+      parent = parent->getParent();
+    }
+    return parent;
+  }
+
+  /** Finds the predecessor of a node of a tree that can be modified. */
+  BSTreeNode<DataType> *getPredecessor(const BSTreeNode<DataType> *node) {
+    return const_cast<BSTreeNode<DataType> *>(
+      std::as_const(*this).getPredecessor(node));
+  }
+
+  /**
+   * @brief Returns an iterator to the smallest key.
+   *
+   * @return The iterator, equal to end() if the tree is empty.
+   */
+  Iterator begin() const {
+    return Iterator(this, getMinimum(root));
+  }
+
+  /**
+   * @brief Returns the iterator past the largest key.
+   *
+   * @return The iterator.
+   */
+  Iterator end() const {
+    return Iterator(this, nullptr);
+  }
+
+  /**
+   * @brief Finds the first key that is not less than a value.
+   *
+   * @param value The value to compare with.
+   * @return Iterator to the key, or end() if every key is less than value.
+   */
+  Iterator lower_bound(const DataType &value) const {
+    return Iterator(this, lowerBound(value));
+  }
+
+  /**
+   * @brief Finds the first key that is greater than a value.
+   *
+   * @param value The value to compare with.
+   * @return Iterator to the key, or end() if no key is greater than value.
+   */
+  Iterator upper_bound(const DataType &value) const {
+    BSTreeNode<DataType> *node = root;
+    BSTreeNode<DataType> *bound = nullptr;
+    while (node != nullptr) {
+      if (value < node->key) {
+        bound = node;
+        node = node->getLeft();
+      } else {
+        node = node->getRight();
+      }
+    }
+    return Iterator(this, bound);
+  }
+
+  /**
+   * @brief Visits, in ascending order, every key in the range [low, high].
+   *
+   * @details Descends once to the first key and then moves to each successor
+   * through parent pointers, without recursion or extra memory. It costs
+   * O(h + k) for a tree of height h and k visited keys.
+   * @param low The smallest key to visit.
+   * @param high The largest key to visit.
+   * @param visit Function called with each key.
+   */
+  template <typename Visitor>
+  void range(const DataType &low, const DataType &high, Visitor visit) const {
+    for (const BSTreeNode<DataType> *node = lowerBound(low);
+      node != nullptr && !(high < node->key); node = getSuccessor(node)) {
+      visit(node->key);
+    }
+  }
+
   /**
    * @brief Performs an inorder traversal of the tree, printing node values.
    *
    * @param rootOfSubtree The subtree root to start the inorder traversal from.
    */
-  void inorderWalk(BSTreeNode<DataType> *rootOfSubtree) const {
-    std::stack<BSTreeNode<DataType> *> stack;
-    BSTreeNode<DataType> *current = rootOfSubtree;
+  void inorderWalk(const BSTreeNode<DataType> *rootOfSubtree) const {
+    std::stack<const BSTreeNode<DataType> *> stack;
+    const BSTreeNode<DataType> *current = rootOfSubtree;
     while (current != nullptr || !stack.empty()) {
       while (current != nullptr) {
         stack.push(current);
@@ -249,18 +593,65 @@ class BSTree {
     }
   }
 
-  /** Could be implemented in the future. */
-  void preorderWalk(BSTreeNode<DataType> *rootOfSubtree) const {}
+  /**
+   * @brief Performs a preorder traversal of the tree, printing node values.
+   *
+   * @details Climbs back through parent pointers instead of using a stack.
+   * @param rootOfSubtree The subtree root to start the preorder traversal
+   * from.
+   */
+  void preorderWalk(const BSTreeNode<DataType> *rootOfSubtree) const {
+    const BSTreeNode<DataType> *current = rootOfSubtree;
+    while (current != nullptr) {
+      std::cout << current->getKey() << " ";
+      if (current->getLeft() != nullptr) {
+        current = current->getLeft();
+      } else if (current->getRight() != nullptr) {
+        current = current->getRight();
+      } else {
+        /** Climb to the first ancestor with an unvisited right subtree. */
+        while (current != rootOfSubtree) {
+          const BSTreeNode<DataType> *parent = current->getParent();
+          if (current == parent->getLeft() && parent->getRight() != nullptr) {
+            current = parent->getRight();
+            break;
+          }
+          current = parent;
+        }
+        if (current == rootOfSubtree) current = nullptr;
+      }
+    }
+  }
 
-  /** Could be implemented in the future. */
-  void postorderWalk(BSTreeNode<DataType> *rootOfSubtree) const {}
+  /**
+   * @brief Performs a postorder traversal of the tree, printing node values.
+   *
+   * @details Climbs back through parent pointers instead of using a stack.
+   * @param rootOfSubtree The subtree root to start the postorder traversal
+   * from.
+   */
+  void postorderWalk(const BSTreeNode<DataType> *rootOfSubtree) const {
+    if (rootOfSubtree == nullptr) return;
+    const BSTreeNode<DataType> *current = firstPostorder(rootOfSubtree);
+    while (true) {
+      std::cout << current->getKey() << " ";
+      if (current == rootOfSubtree) return;
+      const BSTreeNode<DataType> *parent = current->getParent();
+      if (current == parent->getLeft() && parent->getRight() != nullptr) {
+        current = firstPostorder(parent->getRight());
+      } else {
+        current = parent;
+      }
+    }
+  }
 
   /**
    * @brief Deletes a node containing the specified value from the tree.
    *
-   * @param value The value of the node to be deleted.
+   * @param value The value of the node to be deleted; a bare key in a map.
    */
-  void remove(const DataType &value) {
+  template <typename Key>
+  void remove(const Key &value) {
     BSTreeNode<DataType> *node = search(root, value);
     if (node == nullptr) return;
     if (node->getLeft() == nullptr) {
@@ -278,7 +669,7 @@ class BSTree {
       y->setLeft(node->getLeft());
       y->getLeft()->setParent(y);
     }
-    delete node;
+    allocator.destroy(node);
   }
 
   /**
@@ -286,7 +677,12 @@ class BSTree {
    * 
    * @return Pointer to the root node, or nullptr if the tree is empty.
    */
-  BSTreeNode<DataType> *getRoot() const {
+  BSTreeNode<DataType> *getRoot() {
+    return root;
+  }
+
+  /** Retrieves the root of a read-only tree. */
+  const BSTreeNode<DataType> *getRoot() const {
     return root;
   }
 
@@ -302,19 +698,20 @@ class BSTree {
    * linear tree configuration with all nodes linked to the right.
    *
    * @note This method is designed for cases where quick sequential insertions
-   * to the right are acceptable, but it results in an unbalanced tree.
+   * to the right are acceptable, but it results in an unbalanced tree; use
+   * buildFromSorted() to get a balanced one.
    */
   void fastInsert(size_t n) {
     if (root == nullptr) {
       /** If the tree is empty, creates the root node. */
-      root = new BSTreeNode<DataType>(0);
+      root = allocator.create(0);
     }
     BSTreeNode<DataType>* node = root;  /** Starts from the root. */
     for (size_t i = 0; i < n; ++i) {
       while (node->right != nullptr) {
         node = node->right;  /** Goes to the rigth child. */
       }
-      BSTreeNode<DataType>* newNode = new BSTreeNode<DataType>(i);
+      BSTreeNode<DataType>* newNode = allocator.create(i);
       /** Asigns the new node to the rigth child. */
       node->right = newNode;
       /** Asigns the parent of the new node. */
@@ -323,8 +720,88 @@ class BSTree {
     }
   }
 
+  /**
+   * @brief Replaces the contents of the tree with the values of a sorted
+   * range, building a perfectly balanced tree in linear time.
+   *
+   * @details Each subtree takes the middle value of its range as its root, so
+   * the tree has the minimum height, floor(log2(n)) for n values. Nodes are
+   * created in preorder, so with the pool each node is next to its left
+   * child in memory.
+   * @param begin Iterator to the first value.
+   * @param end Iterator past the last value.
+   * @note The values must be in ascending order and without duplicates.
+   */
+  template <typename Iterator>
+  void buildFromSorted(Iterator begin, Iterator end) {
+    clear();
+    root = buildSubtree(begin, std::distance(begin, end), nullptr);
+  }
+
  private:
+  /** Number of lookups that searchBatch() keeps in flight. */
+  static constexpr size_t kBatchWidth = 16;
+
   BSTreeNode<DataType> *root;  /** The root node of the tree. */
+  /** Allocator of the nodes. */
+  Allocator<BSTreeNode<DataType>> allocator;
+
+  /**
+   * @brief Finds the node of the first key that is not less than a value.
+   *
+   * @param value The value to compare with.
+   * @return The node, or nullptr if every key is less than value.
+   */
+  BSTreeNode<DataType> *lowerBound(const DataType &value) const {
+    BSTreeNode<DataType> *node = root;
+    BSTreeNode<DataType> *bound = nullptr;
+    while (node != nullptr) {
+      if (node->key < value) {
+        node = node->getRight();
+      } else {
+        bound = node;
+        node = node->getLeft();
+      }
+    }
+    return bound;
+  }
+
+  /**
+   * @brief Finds the first node of a subtree in postorder, the deepest node
+   * reached by preferring left children.
+   *
+   * @param node The root of the subtree.
+   * @return Pointer to the first node in postorder.
+   */
+  static const BSTreeNode<DataType> *firstPostorder(
+    const BSTreeNode<DataType> *node) {
+    while (node->getLeft() != nullptr || node->getRight() != nullptr) {
+      node = node->getLeft() != nullptr ? node->getLeft() : node->getRight();
+    }
+    return node;
+  }
+
+  /**
+   * @brief Recursive function to build a balanced subtree from a sorted range.
+   *
+   * @param begin Iterator to the first value of the range.
+   * @param n Number of values in the range.
+   * @param parent Parent of the subtree.
+   * @return The root of the subtree, or nullptr if the range is empty.
+   */
+  template <typename Iterator>
+  BSTreeNode<DataType> *buildSubtree(Iterator begin,
+    typename std::iterator_traits<Iterator>::difference_type n,
+    BSTreeNode<DataType> *parent) {
+    if (n <= 0) return nullptr;
+    auto half = n / 2;
+    Iterator middle = std::next(begin, half);
+    BSTreeNode<DataType> *node = allocator.create(*middle);
+    node->parent = parent;
+    node->left = buildSubtree(begin, half, node);
+    node->right = buildSubtree(std::next(middle), n - half - 1, node);
+    return node;
+  }
 
   /**
    * @brief Removes all nodes from the tree in an iterative manner.
@@ -332,9 +809,16 @@ class BSTree {
    * @details This function iteratively traverses the binary search tree using
    * a stack to avoid recursion. It deletes each node in the tree, freeing the
    * memory occupied by each node. After this operation, the tree will be
-   * empty, and the root will be set to nullptr.
+   * empty, and the root will be set to nullptr. If the allocator frees its
+   * nodes in bulk and the keys need no destructor, the nodes are not visited.
    */
   void clear() {
+    if constexpr (Allocator<BSTreeNode<DataType>>::kBulkRelease &&
+      std::is_trivially_destructible_v<DataType>) {
+      allocator.release();
+      root = nullptr;
+      return;
+    }
     if (root == nullptr) return;
     std::stack<BSTreeNode<DataType>*> stack;
     stack.push(root);
@@ -347,8 +831,9 @@ class BSTree {
       if (current->getRight() != nullptr) {
         stack.push(current->getRight());
       }
-      delete current;
+      allocator.destroy(current);
     }
+    allocator.release();
     root = nullptr;
   }
 
@@ -371,3 +856,11 @@ class BSTree {
     }
   }
 };
+
+/**
+ * @brief Binary search tree of keys with mapped values, ordered by key (see
+ * KeyValuePair.hpp).
+ */
+template <typename Key, typename Value,
+  template <typename> class Allocator = NodePool>
+using BSTreeMap = BSTree<KeyValuePair<Key, Value>, Allocator>;
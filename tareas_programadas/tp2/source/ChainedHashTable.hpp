@@ -6,26 +6,240 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "DoublyLinkedList.hpp"
+#include "Hashers.hpp"
+#include "KeyValuePair.hpp"
+#include "Snapshot.hpp"
 
 /**
  * @class ChainedHashTable
  * @brief Implements a hash table with chaining for collision resolution.
  * @tparam DataType Type of data stored in the hash table.
+ * @tparam Hasher Policy that maps a key to a bucket (see Hashers.hpp).
+ * @details The number of buckets follows the number of keys: the table
+ * doubles when the load factor goes above 1 and halves when it drops below
+ * 1/4. Rehashing is incremental: while it is in progress the table keeps the
+ * old buckets next to the new ones, and every insertion or deletion moves a
+ * few old buckets. The operation that starts a rehash only allocates the new
+ * bucket array, which comes zeroed from calloc, and the one that ends it only
+ * frees the old array, so no operation visits every bucket.
  */
-template <typename DataType>
+template <typename DataType, typename Hasher = ModuloHash>
 class ChainedHashTable {
  public:
+  /**
+   * Buckets allocate with new and delete, because a rehash moves nodes from
+   * one bucket to another and a pool per bucket would be too large.
+   */
+  using Bucket = DLList<DataType, NewDeleteAllocator>;
+
+  /**
+   * @class BucketArray
+   * @brief Fixed number of buckets in one block allocated with calloc.
+   * @details A bucket is only the pointer to its sentinel, and a null
+   * sentinel is an empty list, so zeroed memory is already an array of empty
+   * buckets: creating the array does not visit them, and the system maps
+   * zeroed pages as they are first used. The destructor visits the buckets to
+   * delete their nodes; release() frees an array whose buckets are known to
+   * be empty without visiting them.
+   */
+  class BucketArray {
+   public:
+    static_assert(sizeof(Bucket) == sizeof(DLListNode<DataType> *) &&
+      std::is_empty_v<NewDeleteAllocator<DLListNode<DataType>>>,
+      "a zeroed bucket must be an empty list");
+
+    /** Default constructor; the array has no buckets. */
+    BucketArray() = default;
+
+    /**
+     * @brief Constructor of an array of empty buckets.
+     * @param length The number of buckets.
+     */
+    explicit BucketArray(size_t length)
+      : buckets(static_cast<Bucket *>(std::calloc(length, sizeof(Bucket)))),
+        length(length) {
+      if (buckets == nullptr && length > 0) throw std::bad_alloc();
+    }
+
+    /** Move constructor; other is left without buckets. */
+    BucketArray(BucketArray &&other) noexcept {
+      swap(other);
+    }
+
+    /** Move assignment; other receives the old buckets of this array. */
+    BucketArray &operator=(BucketArray &&other) noexcept {
+      swap(other);
+      return *this;
+    }
+
+    /** Destructor; deletes the nodes and sentinels of every bucket. */
+    ~BucketArray() {
+      for (size_t i = 0; i < length; ++i) {
+        buckets[i].~Bucket();
+      }
+      std::free(buckets);
+    }
+
+    /**
+     * @brief Frees the array without visiting its buckets.
+     * @details Every bucket must be empty and without a sentinel, as the old
+     * buckets are once they have all been migrated.
+     */
+    void release() {
+      std::free(buckets);
+      buckets = nullptr;
+      length = 0;
+    }
+
+    /** Exchanges the buckets of two arrays. */
+    void swap(BucketArray &other) noexcept {
+      std::swap(buckets, other.buckets);
+      std::swap(length, other.length);
+    }
+
+    Bucket &operator[](size_t index) {
+      return buckets[index];
+    }
+
+    const Bucket &operator[](size_t index) const {
+      return buckets[index];
+    }
+
+    /** Retrieves the number of buckets. */
+    size_t size() const {
+      return length;
+    }
+
+    /** Checks whether the array has no buckets. */
+    bool empty() const {
+      return length == 0;
+    }
+
+    const Bucket *begin() const {
+      return buckets;
+    }
+
+    const Bucket *end() const {
+      return buckets + length;
+    }
+
+   private:
+    Bucket *buckets = nullptr;  /** The buckets, from calloc. */
+    size_t length = 0;  /** Number of buckets. */
+  };
+
+  /**
+   * @class Iterator
+   * @brief Forward iterator over the keys of the table, bucket by bucket.
+   * @details Walks the nodes in place, without copying or allocating. During
+   * a rehash, the buckets of the new table are visited first and then the old
+   * buckets that have not been moved yet, so every key is visited once. The
+   * order of the keys is unspecified. Inserting or removing keys invalidates
+   * the iterators, because it may move nodes between buckets.
+   */
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = DataType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const DataType *;
+    using reference = const DataType &;
+
+    /** Default constructor; the iterator points to no table. */
+    Iterator() = default;
+
+    reference operator*() const {
+      return node->getKey();
+    }
+
+    pointer operator->() const {
+      return &node->getKey();
+    }
+
+    /** Moves to the next key. */
+    Iterator &operator++() {
+      node = node->getNext();
+      if (node == nil) {
+        node = nullptr;
+        findNode();
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return node == other.node;
+    }
+
+    bool operator!=(const Iterator &other) const {
+      return node != other.node;
+    }
+
+    /**
+     * @brief Retrieves the node the iterator points to.
+     * @return Pointer to the node, or nullptr at the end.
+     */
+    const DLListNode<DataType> *getNode() const {
+      return node;
+    }
+
+   private:
+    friend class ChainedHashTable;
+
+    /** Constructor of an iterator to the first key of a table. */
+    explicit Iterator(const ChainedHashTable *owner)
+      : owner(owner), buckets(&owner->table) {
+      findNode();
+    }
+
+    const ChainedHashTable *owner = nullptr;  /** Table being traversed. */
+    const BucketArray *buckets = nullptr;  /** Current buckets. */
+    size_t index = 0;  /** Next bucket to visit. */
+    const DLListNode<DataType> *nil = nullptr;  /** Sentinel of the bucket. */
+    const DLListNode<DataType> *node = nullptr;  /** Current node. */
+
+    /** Moves to the first node of the next non-empty bucket, if any. */
+    void findNode() {
+      while (node == nullptr) {
+        if (index == buckets->size()) {
+          if (buckets != &owner->table || !owner->isRehashing()) return;
+          /** Continue with the old buckets that were not moved yet. */
+          buckets = &owner->oldTable;
+          index = owner->migrated;
+          continue;
+        }
+        nil = (*buckets)[index++].nil;
+        if (nil != nullptr && nil->getNext() != nil) node = nil->getNext();
+      }
+    }
+  };
+
   /**
    * @brief Constructor that initializes the hash table with a specified number
    * of buckets.
-   * @param size The number of buckets in the hash table.
+   * @param size The initial number of buckets in the hash table. It is
+   * rounded up to a power of two if the hasher requires it.
+   * @param hasher The hasher policy, for hashers that have state (a seed).
    */
-  ChainedHashTable(size_t size) {
-    this->size = size;
-    table.resize(size);
+  ChainedHashTable(size_t size, Hasher hasher = Hasher()) : hasher(hasher) {
+    this->size = validSize(size);
+    table = BucketArray(this->size);
   }
 
   /** Destructor. */
@@ -40,30 +254,184 @@ class ChainedHashTable {
    * before insertion.
    */
   void insert(const DataType &value) {
-    size_t index = hash(value);
-    if (table[index].search(value) == nullptr) {  /** Avoid duplicates. */
-      table[index].insert(value);
+    try_emplace(value);
+  }
+
+  /**
+   * @brief Inserts a value into the hash table, moving it into the node and
+   * avoiding duplicates.
+   * @param value The value to insert.
+   */
+  void insert(DataType &&value) {
+    try_emplace(std::move(value));
+  }
+
+  /**
+   * @brief Inserts a value built in place from its constructor's arguments,
+   * avoiding duplicates.
+   * @param args The arguments of the value's constructor.
+   * @return The node with the value, and whether it was inserted.
+   * @details The value is built before the search, to hash it, and then
+   * moved into the node.
+   */
+  template <typename... Args>
+  std::pair<DLListNode<DataType> *, bool> emplace(Args &&...args) {
+    return try_emplace(DataType(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Inserts a value built in place from a key and the arguments of
+   * the mapped value, unless the key is already in the hash table.
+   * @param key The key, or a whole value; it is only copied or moved if it
+   * is inserted.
+   * @param args The arguments of the mapped value's constructor.
+   * @return The node with the key, and whether it was inserted. Nodes are
+   * relinked, never copied, by rehashes, so the pointer stays valid until the
+   * key is removed.
+   */
+  template <typename Key, typename... Args>
+  std::pair<DLListNode<DataType> *, bool> try_emplace(Key &&key,
+    Args &&...args) {
+    rehashStep();
+    DLListNode<DataType> *node = search(key);
+    if (node != nullptr) return {node, false};  /** Avoid duplicates. */
+    node = table[hash(key, size)].emplace(std::forward<Key>(key),
+      std::forward<Args>(args)...);
+    ++count;
+    if (count > size) {  /** Load factor above 1. */
+      startRehash(2 * size);
     }
+    return {node, true};
   }
 
   /**
    * @brief Searches for a value in the hash table.
-   * @param value The value to search for.
+   * @param value The value to search for; a bare key in a map.
    * @return Pointer to the node containing the value, or nullptr if not found.
+   * @details During a rehash, the value may still be in its old bucket.
    */
-  DLListNode<DataType> *search(const DataType &value) const {
-    size_t index = hash(value);
-    return table[index].search(value);
+  template <typename Key>
+  DLListNode<DataType> *search(const Key &value) {
+    return const_cast<DLListNode<DataType> *>(std::as_const(*this).search(
+      value));
+  }
+
+  /**
+   * @brief Searches a read-only table, whose values cannot be modified.
+   * @param value The value to search for; a bare key in a map.
+   * @return Pointer to the node containing the value, or nullptr if not found.
+   */
+  template <typename Key>
+  const DLListNode<DataType> *search(const Key &value) const {
+    if (isRehashing()) {
+      size_t oldIndex = hash(value, oldTable.size());
+      if (oldIndex >= migrated) {
+        const DLListNode<DataType> *node = oldTable[oldIndex].search(value);
+        if (node != nullptr) return node;
+      }
+    }
+    return table[hash(value, size)].search(value);
+  }
+
+  /**
+   * @brief Searches for many values, interleaving their lookups to overlap
+   * their cache misses.
+   * @param keys The values to search for.
+   * @param n The number of values.
+   * @param results Receives, for each value, what search() would return.
+   * @details Up to kBatchWidth lookups are in flight. Each step of a lookup
+   * reads the bucket, the sentinel or a node that a previous step prefetched,
+   * prefetches the next one and moves on to another lookup, so the misses of
+   * different lookups wait for memory at the same time. A value whose old
+   * bucket has not been migrated yet is searched with search().
+   */
+  void searchBatch(const DataType *keys, size_t n,
+    const DLListNode<DataType> **results) const {
+    /** State of a lookup in flight. */
+    struct Lookup {
+      size_t index;  /** Position of the value in keys. */
+      const Bucket *bucket;  /** Bucket of the value. */
+      const DLListNode<DataType> *node;  /** Node to read in the next step. */
+      int stage;  /** 0: read the bucket, 1: the sentinel, 2: a node. */
+    };
+    Lookup lookups[kBatchWidth];
+    size_t active = 0;
+    size_t next = 0;
+    /** Starts the next value that needs a step; false if none is left. */
+    auto start = [&](Lookup &lookup) {
+      while (next < n) {
+        size_t index = next++;
+        if (isRehashing() &&
+          hash(keys[index], oldTable.size()) >= migrated) {
+          results[index] = search(keys[index]);
+          continue;
+        }
+        lookup = {index, &table[hash(keys[index], size)], nullptr, 0};
+        __builtin_prefetch(lookup.bucket);
+        return true;
+      }
+      return false;
+    };
+    while (active < kBatchWidth && start(lookups[active])) ++active;
+    while (active > 0) {
+      for (size_t slot = 0; slot < active;) {
+        Lookup &lookup = lookups[slot];
+        const DLListNode<DataType> *nil = lookup.bucket->getNil();
+        bool done = false;
+        if (lookup.stage == 0) {
+          /** An empty bucket has no sentinel yet. */
+          done = nil == nullptr;
+          lookup.node = nil;
+          lookup.stage = 1;
+        } else if (lookup.stage == 1) {
+          lookup.node = nil->getNext();
+          lookup.stage = 2;
+        } else if (lookup.node == nil) {
+          lookup.node = nullptr;
+          done = true;
+        } else if (lookup.node->getKey() == keys[lookup.index]) {
+          done = true;
+        } else {
+          lookup.node = lookup.node->getNext();
+        }
+        if (!done) {
+          __builtin_prefetch(lookup.node);
+          ++slot;
+          continue;
+        }
+        results[lookup.index] = lookup.node;
+        if (start(lookup)) {
+          ++slot;
+        } else {
+          /** Fill the slot with the last lookup in flight. */
+          lookup = lookups[--active];
+        }
+      }
+    }
   }
 
   /**
    * @brief Removes a value from the hash table.
-   * @param value The value to remove.
+   * @param value The value to remove; a bare key in a map.
    * @details Removes the value if it exists in the corresponding bucket.
    */
-  void remove(const DataType &value) {
-    size_t index = hash(value);
-    table[index].remove(value);
+  template <typename Key>
+  void remove(const Key &value) {
+    rehashStep();
+    Bucket *bucket = &table[hash(value, size)];
+    if (isRehashing()) {
+      size_t oldIndex = hash(value, oldTable.size());
+      if (oldIndex >= migrated && oldTable[oldIndex].search(value) != nullptr) {
+        bucket = &oldTable[oldIndex];
+      }
+    }
+    DLListNode<DataType> *node = bucket->search(value);
+    if (node == nullptr) return;
+    bucket->remove(node);
+    --count;
+    if (size > kMinSize && count < size / 4) {  /** Load factor below 1/4. */
+      startRehash(size / 2);
+    }
   }
 
   /**
@@ -75,44 +443,334 @@ class ChainedHashTable {
   }
 
   /**
-   * @brief Sets a new size for the hash table and resizes the table.
+   * @brief Retrieves the number of keys stored in the hash table.
+   * @return The number of keys.
+   */
+  size_t getCount() const {
+    return count;
+  }
+
+  /**
+   * @brief Sets a new size for the hash table and redistributes the keys.
    * @param newSize The new number of buckets for the hash table.
+   * @details The rehash is completed before returning. Later insertions and
+   * deletions may still resize the table according to its load factor.
    */
   void setSize(size_t newSize) {
-    size = newSize;
-    table.resize(newSize);
+    startRehash(validSize(newSize));
+    finishRehash();
+  }
+
+  /**
+   * @brief Computes the distribution of chain lengths.
+   * @return A vector whose i-th entry is the number of buckets with i keys.
+   * @details Keys of a rehash in progress are counted in their new buckets.
+   */
+  std::vector<size_t> getChainLengthHistogram() const {
+    std::vector<size_t> lengths(size, 0);
+    countKeys(table, 0, lengths);
+    countKeys(oldTable, migrated, lengths);
+    std::vector<size_t> histogram;
+    for (size_t length : lengths) {
+      if (length >= histogram.size()) histogram.resize(length + 1, 0);
+      ++histogram[length];
+    }
+    return histogram;
+  }
+
+  /**
+   * @brief Returns an iterator to the first key.
+   * @return The iterator, equal to end() if the table is empty.
+   */
+  Iterator begin() const {
+    return Iterator(this);
+  }
+
+  /**
+   * @brief Returns the iterator past the last key.
+   * @return The iterator.
+   */
+  Iterator end() const {
+    return Iterator();
+  }
+
+  /**
+   * @brief Calls a function with every key of the table, in place.
+   * @param visit Function called with each key, in an unspecified order.
+   */
+  template <typename Visitor>
+  void forEach(Visitor visit) const {
+    visitKeys(table, 0, table.size(), visit);
+    visitKeys(oldTable, migrated, oldTable.size(), visit);
+  }
+
+  /**
+   * @brief Calls a function with every key of the table, splitting the
+   * buckets in contiguous ranges among several threads.
+   * @param threads The number of threads, at least 1; the calling thread is
+   * one of them.
+   * @param visit Function called as visit(worker, key), where worker is the
+   * index of the thread, from 0 to threads - 1. It is called from several
+   * threads at the same time, so it should only write to data of its worker,
+   * such as one partial result per worker, which the caller then combines.
+   * @details No thread may modify the table during the scan.
+   */
+  template <typename Visitor>
+  void forEachParallel(size_t threads, Visitor visit) const {
+    if (threads == 0) threads = 1;
+    auto work = [this, threads, &visit](size_t worker) {
+      auto visitKey = [worker, &visit](const DataType &key) {
+        visit(worker, key);
+      };
+      visitKeys(table, share(0, table.size(), worker, threads),
+        share(0, table.size(), worker + 1, threads), visitKey);
+      if (isRehashing()) {
+        visitKeys(oldTable, share(migrated, oldTable.size(), worker, threads),
+          share(migrated, oldTable.size(), worker + 1, threads), visitKey);
+      }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t worker = 1; worker < threads; ++worker) {
+      workers.emplace_back(work, worker);
+    }
+    work(0);
+    for (std::thread &worker : workers) {
+      worker.join();
+    }
   }
 
   /**
-   * @brief Retrieves the current hash table.
-   * @return A vector of doubly linked lists representing the table buckets.
+   * @brief Retrieves the current hash table, without copying it.
+   * @return The buckets. A rehash in progress is completed first, so that
+   * they hold every key.
    */
-  std::vector<DLList<DataType>> getTable() const {
+  const BucketArray &getTable() {
+    finishRehash();
     return table;
   }
 
   /**
    * @brief Sets a new hash table.
    * @param newTable A vector of doubly linked lists to replace the current
-   * table.
+   * table. Its keys must already be in the buckets given by the hash function
+   * for newTable.size() buckets. If the hasher requires a power of two number
+   * of buckets and newTable has another size, the keys are redistributed.
    */
-  void setTable(std::vector<DLList<DataType>> newTable) {
-    table = newTable;
+  void setTable(std::vector<Bucket> newTable) {
+    clear();
+    table = BucketArray(std::max<size_t>(newTable.size(), 1));
+    for (size_t i = 0; i < newTable.size(); ++i) {
+      table[i] = std::move(newTable[i]);
+    }
+    size = table.size();
+    for (const Bucket &bucket : table) {
+      if (bucket.nil == nullptr) continue;
+      for (DLListNode<DataType> *node = bucket.nil->getNext();
+        node != bucket.nil; node = node->getNext()) {
+        ++count;
+      }
+    }
+    if (validSize(size) != size) setSize(size);
+  }
+
+  /**
+   * @brief Saves the keys and the number of buckets to a binary snapshot
+   * file (see Snapshot.hpp).
+   * @param path Path of the file, which is replaced if it exists.
+   * @return True if the file was written completely.
+   * @details The keys are written bucket by bucket, in the byte order of this
+   * machine. DataType must be trivially copyable. The number of buckets saved
+   * is at most twice the number of keys (or of kMinSize), the most that
+   * loadSnapshot() accepts.
+   */
+  bool saveSnapshot(const char *path) const {
+    size_t buckets = std::min(size, 2 * std::max(count, kMinSize));
+    SnapshotWriter<DataType> writer(path, kSnapshotChainedHashTable, buckets);
+    forEach([&writer](const DataType &key) { writer.add(key); });
+    return writer.finish();
+  }
+
+  /**
+   * @brief Replaces the keys of the table with those of a snapshot file.
+   * @param path Path of a file written by saveSnapshot().
+   * @return True if the file was loaded. If it cannot be read or its header
+   * is wrong, the table is left unchanged and false is returned.
+   * @details The file is mapped into memory and each key is pushed into its
+   * bucket in the saved number of buckets, without checking for duplicates
+   * and without rehashing, so loading takes linear time. The saved number of
+   * buckets is rejected if it is 0 or more than twice the number of keys (or
+   * of kMinSize), and raised to the number of keys if it is below it. The new
+   * buckets are filled before the old ones are cleared.
+   */
+  bool loadSnapshot(const char *path) {
+    SnapshotReader<DataType> reader(path, kSnapshotChainedHashTable);
+    if (!reader.isValid()) return false;
+    const SnapshotHeader &header = reader.getHeader();
+    if (header.buckets == 0 ||
+      header.buckets > 2 * std::max<uint64_t>(header.count, kMinSize)) {
+      return false;
+    }
+    size_t buckets = validSize(std::max(header.buckets, header.count));
+    BucketArray loaded(buckets);
+    for (const DataType *key = reader.begin(); key != reader.end(); ++key) {
+      loaded[hash(*key, buckets)].insert(*key);
+    }
+    clear();
+    table.swap(loaded);
+    size = buckets;
+    count = header.count;
+    return true;
   }
 
  private:
+  /** Number of old buckets moved on each insertion or deletion. */
+  static constexpr size_t kMigrationStep = 4;
+  /** The table does not shrink below this number of buckets. */
+  static constexpr size_t kMinSize = 8;
+  /** Number of lookups that searchBatch() keeps in flight. */
+  static constexpr size_t kBatchWidth = 16;
+
   size_t size;  /** Number of buckets in the hash table. */
-  /** Hash table represented by a vector of doubly linked lists. */
-  std::vector<DLList<DataType>> table;
+  size_t count = 0;  /** Number of keys in the hash table. */
+  /** Hash table represented by an array of doubly linked lists. */
+  BucketArray table;
+  /** Buckets before the rehash in progress; empty if there is none. */
+  BucketArray oldTable;
+  /** Old buckets below this index have already been moved. */
+  size_t migrated = 0;
+  Hasher hasher;  /** Policy that maps keys to buckets. */
 
   /**
    * @brief Hash function that computes the bucket index for a given key.
-   * @param key The key to hash.
+   * @param key The key to hash: a value, or a bare key in a map.
+   * @param buckets The number of buckets.
    * @return The index of the bucket for the key.
-   * @details Uses a simple mod hash function: h(k) = k % m.
+   * @details Delegates to the hasher policy; the default is the simple mod
+   * hash function h(k) = k % m. The values of a map are hashed by their key.
+   */
+  template <typename Key>
+  size_t hash(const Key &key, size_t buckets) const {
+    return hasher(keyOf(key), buckets);
+  }
+
+  /**
+   * @brief Adjusts a requested number of buckets: at least one, and a power
+   * of two if the hasher requires it.
+   */
+  static size_t validSize(size_t buckets) {
+    if (buckets == 0) buckets = 1;
+    if constexpr (Hasher::kPowerOfTwo) {
+      size_t power = 1;
+      while (power < buckets) power *= 2;
+      buckets = power;
+    }
+    return buckets;
+  }
+
+  /**
+   * @brief Adds the keys of the buckets from 'first' on to the lengths of
+   * their buckets in the current table.
+   */
+  void countKeys(const BucketArray &buckets, size_t first,
+    std::vector<size_t> &lengths) const {
+    for (size_t i = first; i < buckets.size(); ++i) {
+      const Bucket &bucket = buckets[i];
+      if (bucket.nil == nullptr) continue;
+      for (DLListNode<DataType> *node = bucket.nil->getNext();
+        node != bucket.nil; node = node->getNext()) {
+        ++lengths[hash(node->getKey(), size)];
+      }
+    }
+  }
+
+  /**
+   * @brief Calls a function with the keys of the buckets in [first, last).
+   */
+  template <typename Visitor>
+  static void visitKeys(const BucketArray &buckets, size_t first,
+    size_t last, Visitor &visit) {
+    for (size_t i = first; i < last; ++i) {
+      const DLListNode<DataType> *nil = buckets[i].nil;
+      if (nil == nullptr) continue;
+      for (const DLListNode<DataType> *node = nil->getNext(); node != nil;
+        node = node->getNext()) {
+        visit(node->getKey());
+      }
+    }
+  }
+
+  /**
+   * @brief Splits the range [first, last) in equal parts.
+   * @return The start of the given part, or last for part == parts.
+   */
+  static size_t share(size_t first, size_t last, size_t part, size_t parts) {
+    return first + (last - first) * part / parts;
+  }
+
+  /** Checks whether a rehash is in progress. */
+  bool isRehashing() const {
+    return !oldTable.empty();
+  }
+
+  /**
+   * @brief Starts moving the keys to a table with a new number of buckets.
+   * @param newSize The new number of buckets.
+   * @details A rehash already in progress is completed first. The new
+   * buckets come zeroed from calloc and do not allocate until they receive
+   * keys, so starting a rehash does not visit them.
    */
-  size_t hash(const DataType &key) const {
-    return key % size;
+  void startRehash(size_t newSize) {
+    finishRehash();
+    oldTable.swap(table);
+    table = BucketArray(newSize);
+    size = newSize;
+    migrated = 0;
+  }
+
+  /**
+   * @brief Moves up to kMigrationStep non-empty old buckets to the new table.
+   * @details Visits at most ten times that many buckets, so that long runs of
+   * empty buckets do not make a single operation slow.
+   */
+  void rehashStep() {
+    if (!isRehashing()) return;
+    size_t moved = 0;
+    size_t visits = 10 * kMigrationStep;
+    while (migrated < oldTable.size() && moved < kMigrationStep &&
+      visits > 0) {
+      if (!oldTable[migrated].isEmpty()) ++moved;
+      migrateBucket(migrated++);
+      --visits;
+    }
+    if (migrated == oldTable.size()) {
+      oldTable.release();
+      migrated = 0;
+    }
+  }
+
+  /** Completes the rehash in progress, if any. */
+  void finishRehash() {
+    while (isRehashing()) {
+      migrateBucket(migrated++);
+      if (migrated == oldTable.size()) {
+        oldTable.release();
+        migrated = 0;
+      }
+    }
+  }
+
+  /**
+   * @brief Relinks the nodes of an old bucket into the new table, without
+   * copying them, and frees the old bucket's sentinel.
+   * @param index The index of the old bucket.
+   */
+  void migrateBucket(size_t index) {
+    Bucket &bucket = oldTable[index];
+    while (DLListNode<DataType> *node = bucket.popFront()) {
+      table[hash(node->getKey(), size)].pushFront(node);
+    }
+    bucket.reset();
   }
 
   /**
@@ -120,8 +778,18 @@ class ChainedHashTable {
    * @details Deletes all elements in each linked list of the table.
    */
   void clear() {
-    for (auto &list : table) {
-      list.clear();
+    for (size_t i = 0; i < table.size(); ++i) {
+      table[i].clear();
     }
+    oldTable = BucketArray();
+    migrated = 0;
+    count = 0;
   }
 };
+
+/**
+ * @brief Hash table of keys with mapped values, hashed by key (see
+ * KeyValuePair.hpp).
+ */
+template <typename Key, typename Value, typename Hasher = ModuloHash>
+using ChainedHashMap = ChainedHashTable<KeyValuePair<Key, Value>, Hasher>;
@@ -0,0 +1,267 @@
+/*
+ * Credits
+ * Based on: Prof. Arturo Camacho, Universidad de Costa Rica
+ * Template provided by: Prof. Allan Berrocal Rojas
+ * Adapted by: Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+#include "EpochReclamation.hpp"
+#include "Hashers.hpp"
+
+/**
+ * @class ConcurrentHashTable
+ * @brief Implements a hash table with chaining that many threads can use at
+ * the same time.
+ * @tparam DataType Type of data stored in the hash table.
+ * @tparam Hasher Policy that maps a key to a bucket (see Hashers.hpp).
+ * @details Writers lock one of kStripes mutexes, chosen by bucket, so
+ * insertions and deletions on different stripes run in parallel. Searches
+ * take no lock: chains are singly linked lists of atomic pointers, a new
+ * node is fully built before it is published at the head of its chain, and
+ * an unlinked node keeps its next pointer, so a reader walks a consistent
+ * chain in a bounded number of steps. Unlinked nodes are freed through
+ * EpochReclamation once no reader can hold them. To resize, a writer locks
+ * every stripe, copies the keys into a new table, publishes it and retires
+ * the old one; readers still in the old table keep seeing valid chains.
+ */
+template <typename DataType, typename Hasher = ModuloHash>
+class ConcurrentHashTable {
+ public:
+  /**
+   * @brief Constructor that initializes the hash table with a specified number
+   * of buckets.
+   * @param size The initial number of buckets in the hash table.
+   * @param hasher The hasher policy, for hashers that have state (a seed).
+   */
+  ConcurrentHashTable(size_t size, Hasher hasher = Hasher()) : hasher(hasher) {
+    current.store(new Table(validSize(size)));
+  }
+
+  /**
+   * @brief Destructor. No other thread may be using the table.
+   */
+  ~ConcurrentHashTable() {
+    delete current.load();
+  }
+
+  /** The table owns its nodes, so it cannot be copied. */
+  ConcurrentHashTable(const ConcurrentHashTable &) = delete;
+  ConcurrentHashTable &operator=(const ConcurrentHashTable &) = delete;
+
+  /**
+   * @brief Inserts a value into the hash table, avoiding duplicates.
+   * @param value The value to insert.
+   */
+  void insert(const DataType &value) {
+    EpochReclamation::Guard guard;
+    Table *table;
+    {
+      Locked locked = lockBucket(value);
+      table = locked.table;
+      std::atomic<Node *> &head = table->buckets[locked.index];
+      for (Node *node = head.load(std::memory_order_relaxed); node != nullptr;
+        node = node->next.load(std::memory_order_relaxed)) {
+        if (node->key == value) return;  /** Avoid duplicates. */
+      }
+      Node *node = new Node(value, head.load(std::memory_order_relaxed));
+      head.store(node, std::memory_order_release);
+    }
+    size_t keys = count.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (keys > table->size) {  /** Load factor above 1. */
+      resize(table, 2 * table->size);
+    }
+  }
+
+  /**
+   * @brief Searches for a value in the hash table without taking locks.
+   * @param value The value to search for.
+   * @return True if the value is in the table.
+   * @details Returns a boolean instead of a node, because another thread may
+   * remove and free the node as soon as the search ends.
+   */
+  bool search(const DataType &value) const {
+    EpochReclamation::Guard guard;
+    Table *table = current.load(std::memory_order_acquire);
+    const std::atomic<Node *> &head = table->buckets[hash(value, table->size)];
+    for (Node *node = head.load(std::memory_order_acquire); node != nullptr;
+      node = node->next.load(std::memory_order_acquire)) {
+      if (node->key == value) return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Removes a value from the hash table.
+   * @param value The value to remove.
+   */
+  void remove(const DataType &value) {
+    EpochReclamation::Guard guard;
+    Table *table;
+    Node *removed = nullptr;
+    {
+      Locked locked = lockBucket(value);
+      table = locked.table;
+      std::atomic<Node *> *link = &table->buckets[locked.index];
+      for (Node *node = link->load(std::memory_order_relaxed); node != nullptr;
+        node = node->next.load(std::memory_order_relaxed)) {
+        if (node->key == value) {
+          /** Readers on this node can still follow its next pointer. */
+          link->store(node->next.load(std::memory_order_relaxed),
+            std::memory_order_release);
+          removed = node;
+          break;
+        }
+        link = &node->next;
+      }
+    }
+    if (removed == nullptr) return;
+    EpochReclamation::instance().retire(removed);
+    size_t keys = count.fetch_sub(1, std::memory_order_relaxed) - 1;
+    if (table->size > kMinSize && keys < table->size / 4) {
+      resize(table, table->size / 2);  /** Load factor below 1/4. */
+    }
+  }
+
+  /**
+   * @brief Retrieves the current size (number of buckets) of the hash table.
+   * @return The number of buckets in the hash table.
+   */
+  size_t getSize() const {
+    EpochReclamation::Guard guard;
+    return current.load(std::memory_order_acquire)->size;
+  }
+
+  /**
+   * @brief Retrieves the number of keys stored in the hash table.
+   * @return The number of keys; approximate while other threads write.
+   */
+  size_t getCount() const {
+    return count.load(std::memory_order_relaxed);
+  }
+
+ private:
+  /** Number of mutexes shared by the buckets. */
+  static constexpr size_t kStripes = 64;
+  /** The table does not shrink below this number of buckets. */
+  static constexpr size_t kMinSize = 64;
+
+  /** A node of a chain. */
+  struct Node {
+    DataType key;  /** Value stored in the node. */
+    std::atomic<Node *> next;  /** Next node of the chain. */
+
+    Node(const DataType &key, Node *next) : key(key), next(next) {}
+  };
+
+  /** An array of chains; replaced as a whole when the table resizes. */
+  struct Table {
+    size_t size;  /** Number of buckets. */
+    std::atomic<Node *> *buckets;  /** Head of each chain. */
+
+    explicit Table(size_t size)
+      : size(size), buckets(new std::atomic<Node *>[size]) {
+      for (size_t i = 0; i < size; ++i) {
+        buckets[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    /** Deletes the chains, which nobody else can be reading. */
+    ~Table() {
+      for (size_t i = 0; i < size; ++i) {
+        Node *node = buckets[i].load(std::memory_order_relaxed);
+        while (node != nullptr) {
+          Node *next = node->next.load(std::memory_order_relaxed);
+          delete node;
+          node = next;
+        }
+      }
+      delete[] buckets;
+    }
+  };
+
+  /** A mutex on its own cache line. */
+  struct alignas(64) Stripe {
+    std::mutex mutex;
+  };
+
+  /** A bucket of the current table whose stripe is locked. */
+  struct Locked {
+    std::unique_lock<std::mutex> lock;  /** Lock of the bucket's stripe. */
+    Table *table;  /** Table that was current when the lock was taken. */
+    size_t index;  /** Index of the bucket. */
+  };
+
+  std::atomic<Table *> current;  /** The table readers and writers use. */
+  std::atomic<size_t> count{0};  /** Number of keys in the hash table. */
+  Stripe stripes[kStripes];  /** Locks of the buckets. */
+  Hasher hasher;  /** Policy that maps keys to buckets. */
+
+  /**
+   * @brief Hash function that computes the bucket index for a given key.
+   * @param key The key to hash.
+   * @param buckets The number of buckets.
+   * @return The index of the bucket for the key.
+   */
+  size_t hash(const DataType &key, size_t buckets) const {
+    return hasher(key, buckets);
+  }
+
+  /** Adjusts a requested number of buckets like ChainedHashTable does. */
+  static size_t validSize(size_t buckets) {
+    if (buckets < kStripes) buckets = kStripes;
+    if constexpr (Hasher::kPowerOfTwo) {
+      size_t power = 1;
+      while (power < buckets) power *= 2;
+      buckets = power;
+    }
+    return buckets;
+  }
+
+  /**
+   * @brief Locks the stripe of the bucket of a value in the current table.
+   * @details If a resize publishes a new table between reading the table and
+   * taking the lock, the lock is released and taken again on the new table.
+   * The caller must be pinned.
+   */
+  Locked lockBucket(const DataType &value) {
+    while (true) {
+      Table *table = current.load(std::memory_order_acquire);
+      size_t index = hash(value, table->size);
+      std::unique_lock<std::mutex> lock(stripes[index % kStripes].mutex);
+      if (current.load(std::memory_order_acquire) == table) {
+        return {std::move(lock), table, index};
+      }
+    }
+  }
+
+  /**
+   * @brief Replaces the table with one of a new size.
+   * @param expected The table that needed the resize; nothing is done if
+   * another thread already replaced it.
+   * @param newSize The new number of buckets.
+   */
+  void resize(Table *expected, size_t newSize) {
+    for (Stripe &stripe : stripes) stripe.mutex.lock();
+    Table *table = current.load(std::memory_order_relaxed);
+    if (table == expected) {
+      Table *resized = new Table(validSize(newSize));
+      for (size_t i = 0; i < table->size; ++i) {
+        for (Node *node = table->buckets[i].load(std::memory_order_relaxed);
+          node != nullptr; node = node->next.load(std::memory_order_relaxed)) {
+          std::atomic<Node *> &head =
+            resized->buckets[hash(node->key, resized->size)];
+          head.store(new Node(node->key, head.load(std::memory_order_relaxed)),
+            std::memory_order_relaxed);
+        }
+      }
+      current.store(resized, std::memory_order_release);
+    }
+    for (Stripe &stripe : stripes) stripe.mutex.unlock();
+    if (table == expected) EpochReclamation::instance().retire(table);
+  }
+};
@@ -0,0 +1,326 @@
+/*
+ * Credits
+ * Based on: Prof. Arturo Camacho, Universidad de Costa Rica
+ * Template provided by: Prof. Allan Berrocal Rojas
+ * Adapted by: Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "EpochReclamation.hpp"
+
+/**
+ * @class ConcurrentSkipList
+ * @brief Implements an ordered set as a lock-free skip list that many threads
+ * can use at the same time.
+ * @tparam DataType Type of data stored in the skip list.
+ * @details Each node is linked in levels 0 to height - 1, and each level is a
+ * sorted linked list that skips more nodes than the one below, so a search
+ * takes O(log n) steps. Nodes are linked and unlinked with compare-and-swap.
+ * To remove a node, its next pointers are marked from the top level down, by
+ * setting their lowest bit, and the thread that marks level 0 owns the
+ * removal; a marked node is logically gone, and later traversals unlink it.
+ * Searches never write. Unlinked nodes are freed through EpochReclamation
+ * once both the thread that inserted the node and the one that removed it
+ * are done with it, because an insertion can still be linking the upper
+ * levels of a node that is being removed.
+ */
+template <typename DataType>
+class ConcurrentSkipList {
+ public:
+  /** Constructor. */
+  ConcurrentSkipList() {
+    head = createNode(DataType(), kMaxLevel);
+  }
+
+  /**
+   * @brief Destructor. No other thread may be using the skip list.
+   */
+  ~ConcurrentSkipList() {
+    Node *node = head;
+    while (node != nullptr) {
+      Node *next = unmarked(node->next(0).load(std::memory_order_relaxed));
+      destroyNode(node);
+      node = next;
+    }
+  }
+
+  /** The skip list owns its nodes, so it cannot be copied. */
+  ConcurrentSkipList(const ConcurrentSkipList &) = delete;
+  ConcurrentSkipList &operator=(const ConcurrentSkipList &) = delete;
+
+  /**
+   * @brief Inserts a value into the skip list, avoiding duplicates.
+   * @param value The value to insert.
+   */
+  void insert(const DataType &value) {
+    EpochReclamation::Guard guard;
+    Node *preds[kMaxLevel];
+    Node *succs[kMaxLevel];
+    Node *node = nullptr;
+    while (true) {
+      if (find(value, preds, succs)) {
+        /** Avoid duplicates; the node was never published. */
+        if (node != nullptr) destroyNode(node);
+        return;
+      }
+      if (node == nullptr) node = createNode(value, randomHeight());
+      for (int level = 0; level < node->height; ++level) {
+        node->next(level).store(pointer(succs[level]),
+          std::memory_order_relaxed);
+      }
+      /** Linking level 0 inserts the value. */
+      uintptr_t expected = pointer(succs[0]);
+      if (preds[0]->next(0).compare_exchange_strong(expected, pointer(node),
+        std::memory_order_release, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    count.fetch_add(1, std::memory_order_relaxed);
+    linkUpperLevels(node, preds, succs);
+    if (isMarked(node->next(0).load(std::memory_order_acquire))) {
+      /** It was removed meanwhile; unlink what this thread linked late. */
+      find(value, preds, succs);
+    }
+    release(node);
+  }
+
+  /**
+   * @brief Searches for a value in the skip list without writing to it.
+   * @param value The value to search for.
+   * @return True if the value is in the skip list.
+   */
+  bool search(const DataType &value) const {
+    EpochReclamation::Guard guard;
+    Node *pred = head;
+    Node *curr = nullptr;
+    for (int level = kMaxLevel - 1; level >= 0; --level) {
+      curr = unmarked(pred->next(level).load(std::memory_order_acquire));
+      while (curr != nullptr) {
+        uintptr_t next = curr->next(level).load(std::memory_order_acquire);
+        if (isMarked(next)) {
+          curr = unmarked(next);  /** Skip removed nodes. */
+        } else if (curr->key < value) {
+          pred = curr;
+          curr = unmarked(next);
+        } else {
+          break;
+        }
+      }
+    }
+    return curr != nullptr && curr->key == value &&
+      !isMarked(curr->next(0).load(std::memory_order_acquire));
+  }
+
+  /**
+   * @brief Removes a value from the skip list.
+   * @param value The value to remove.
+   */
+  void remove(const DataType &value) {
+    EpochReclamation::Guard guard;
+    Node *preds[kMaxLevel];
+    Node *succs[kMaxLevel];
+    if (!find(value, preds, succs)) return;
+    Node *node = succs[0];
+    for (int level = node->height - 1; level > 0; --level) {
+      uintptr_t next = node->next(level).load(std::memory_order_relaxed);
+      while (!isMarked(next) && !node->next(level).compare_exchange_weak(
+        next, next | kMark, std::memory_order_acq_rel)) {
+      }
+    }
+    uintptr_t next = node->next(0).load(std::memory_order_relaxed);
+    while (!isMarked(next)) {
+      if (node->next(0).compare_exchange_weak(next, next | kMark,
+        std::memory_order_acq_rel)) {
+        /** This thread removed the value; unlink the node everywhere. */
+        count.fetch_sub(1, std::memory_order_relaxed);
+        find(value, preds, succs);
+        release(node);
+        return;
+      }
+    }
+    /** Another thread removed it first. */
+  }
+
+  /**
+   * @brief Visits, in ascending order, the keys in the range [low, high].
+   * @param low The smallest key to visit.
+   * @param high The largest key to visit.
+   * @param visit Function called with each key.
+   * @details The scan is not atomic: keys inserted or removed by other
+   * threads while it runs may or may not be visited.
+   */
+  template <typename Visitor>
+  void range(const DataType &low, const DataType &high, Visitor visit) const {
+    EpochReclamation::Guard guard;
+    Node *pred = head;
+    for (int level = kMaxLevel - 1; level >= 0; --level) {
+      Node *curr = unmarked(pred->next(level).load(std::memory_order_acquire));
+      while (curr != nullptr && curr->key < low) {
+        pred = curr;
+        curr = unmarked(curr->next(level).load(std::memory_order_acquire));
+      }
+    }
+    Node *curr = unmarked(pred->next(0).load(std::memory_order_acquire));
+    while (curr != nullptr && !(high < curr->key)) {
+      uintptr_t next = curr->next(0).load(std::memory_order_acquire);
+      if (!isMarked(next) && !(curr->key < low)) visit(curr->key);
+      curr = unmarked(next);
+    }
+  }
+
+  /**
+   * @brief Retrieves the number of keys stored in the skip list.
+   * @return The number of keys; approximate while other threads write.
+   */
+  size_t getCount() const {
+    return count.load(std::memory_order_relaxed);
+  }
+
+ private:
+  /** Maximum number of levels; enough for about 2^24 keys. */
+  static constexpr int kMaxLevel = 24;
+  /** Bit of a next pointer that marks its node as removed. */
+  static constexpr uintptr_t kMark = 1;
+
+  /** A node, followed in the same allocation by its height next pointers. */
+  struct alignas(std::atomic<uintptr_t>) Node {
+    DataType key;  /** Value stored in the node. */
+    int height;  /** Number of levels the node is linked in. */
+    /** Threads that still use the node: its inserter and its remover. */
+    std::atomic<int> owners{2};
+
+    Node(const DataType &key, int height) : key(key), height(height) {}
+
+    /** Next pointer of a level, stored right after the node. */
+    std::atomic<uintptr_t> &next(int level) {
+      return reinterpret_cast<std::atomic<uintptr_t> *>(this + 1)[level];
+    }
+  };
+
+  Node *head;  /** Sentinel before the first key, linked in every level. */
+  std::atomic<size_t> count{0};  /** Number of keys in the skip list. */
+
+  static bool isMarked(uintptr_t next) {
+    return (next & kMark) != 0;
+  }
+
+  static Node *unmarked(uintptr_t next) {
+    return reinterpret_cast<Node *>(next & ~kMark);
+  }
+
+  static uintptr_t pointer(Node *node) {
+    return reinterpret_cast<uintptr_t>(node);
+  }
+
+  /** Creates a node and its next pointers in one allocation. */
+  static Node *createNode(const DataType &key, int height) {
+    void *memory = ::operator new(sizeof(Node) +
+      height * sizeof(std::atomic<uintptr_t>));
+    Node *node = new (memory) Node(key, height);
+    auto *next = reinterpret_cast<std::atomic<uintptr_t> *>(node + 1);
+    for (int level = 0; level < height; ++level) {
+      new (next + level) std::atomic<uintptr_t>(0);
+    }
+    return node;
+  }
+
+  /** Destroys a node created by createNode(). */
+  static void destroyNode(void *memory) {
+    static_cast<Node *>(memory)->~Node();
+    ::operator delete(memory);
+  }
+
+  /**
+   * @brief Chooses the height of a new node: 1 with probability 1/2, 2 with
+   * probability 1/4, and so on.
+   */
+  static int randomHeight() {
+    thread_local uint64_t state =
+      0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(&state);
+    /** xorshift64 generator. */
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    int height = 1;
+    uint64_t bits = state;
+    while ((bits & 1) != 0 && height < kMaxLevel) {
+      ++height;
+      bits >>= 1;
+    }
+    return height;
+  }
+
+  /**
+   * @brief Finds, in every level, the last node before a value and the first
+   * node not before it, unlinking the removed nodes on the way.
+   * @param value The value to search for.
+   * @param preds Receives the last node before the value in each level.
+   * @param succs Receives the first node not before the value in each level.
+   * @return True if the value is in the skip list.
+   */
+  bool find(const DataType &value, Node **preds, Node **succs) {
+  retry:
+    Node *pred = head;
+    Node *curr = nullptr;
+    for (int level = kMaxLevel - 1; level >= 0; --level) {
+      curr = unmarked(pred->next(level).load(std::memory_order_acquire));
+      while (curr != nullptr) {
+        uintptr_t next = curr->next(level).load(std::memory_order_acquire);
+        if (isMarked(next)) {
+          uintptr_t expected = pointer(curr);
+          if (!pred->next(level).compare_exchange_strong(expected,
+            next & ~kMark, std::memory_order_acq_rel)) {
+            goto retry;  /** The predecessor changed or was removed. */
+          }
+          curr = unmarked(next);
+        } else if (curr->key < value) {
+          pred = curr;
+          curr = unmarked(next);
+        } else {
+          break;
+        }
+      }
+      preds[level] = pred;
+      succs[level] = curr;
+    }
+    return curr != nullptr && curr->key == value;
+  }
+
+  /**
+   * @brief Links a node that is already in level 0 into its upper levels.
+   * @details Stops early if the node is removed meanwhile.
+   */
+  void linkUpperLevels(Node *node, Node **preds, Node **succs) {
+    for (int level = 1; level < node->height; ++level) {
+      while (true) {
+        uintptr_t next = node->next(level).load(std::memory_order_acquire);
+        if (isMarked(next)) return;
+        if (unmarked(next) != succs[level] &&
+          !node->next(level).compare_exchange_strong(next,
+            pointer(succs[level]), std::memory_order_acq_rel)) {
+          continue;  /** It was marked meanwhile. */
+        }
+        uintptr_t expected = pointer(succs[level]);
+        if (preds[level]->next(level).compare_exchange_strong(expected,
+          pointer(node), std::memory_order_release,
+          std::memory_order_relaxed)) {
+          break;
+        }
+        /** The neighbors changed; search them again. */
+        if (!find(node->key, preds, succs) || succs[0] != node) return;
+      }
+    }
+  }
+
+  /** Retires a node once its inserter and its remover are done with it. */
+  void release(Node *node) {
+    if (node->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      EpochReclamation::instance().retire(node, &destroyNode);
+    }
+  }
+};
@@ -6,8 +6,13 @@
  */
 
 #pragma once
+#include <type_traits>
+#include <utility>
 
-template <typename DataType>
+#include "KeyValuePair.hpp"
+#include "NodePool.hpp"
+
+template <typename DataType, template <typename> class Allocator>
 class DLList;
 
 /**
@@ -18,7 +23,8 @@ class DLList;
 template <typename DataType>
 class DLListNode {
  public:
-  friend class DLList<DataType>;
+  template <typename, template <typename> class>
+  friend class DLList;
 
   /**
    * @brief Default constructor.
@@ -43,22 +49,49 @@ class DLListNode {
     this->prev = prev;
   }
 
+  /**
+   * @brief Constructor that builds the value in place.
+   * @param args The arguments of the value's constructor.
+   */
+  template <typename... Args>
+  explicit DLListNode(std::in_place_t, Args &&...args)
+    : key(std::forward<Args>(args)...), next(nullptr), prev(nullptr) {}
+
   /** Destructor. */
   ~DLListNode() {}
 
   /**
    * @brief Retrieves the value stored in the node.
-   * @return The value stored in the node.
+   * @return Reference to the value stored in the node.
    */
-  DataType getKey() const {
+  const DataType &getKey() const {
     return key;
   }
 
+  /**
+   * @brief Retrieves the mapped value, in a node of a map (see
+   * KeyValuePair.hpp).
+   * @return Reference to the value, which can be modified in place.
+   */
+  auto &getValue() {
+    return key.value;
+  }
+
+  /** Retrieves the mapped value of a read-only node. */
+  const auto &getValue() const {
+    return key.value;
+  }
+
   /**
    * @brief Retrieves a pointer to the previous node.
    * @return Pointer to the previous node.
    */
-  DLListNode<DataType> *getPrev() const {
+  DLListNode<DataType> *getPrev() {
+    return prev;
+  }
+
+  /** Retrieves the previous node of a read-only node, also read-only. */
+  const DLListNode<DataType> *getPrev() const {
     return prev;
   }
 
@@ -66,7 +99,12 @@ class DLListNode {
    * @brief Retrieves a pointer to the next node.
    * @return Pointer to the next node.
    */
-  DLListNode<DataType> *getNext() const {
+  DLListNode<DataType> *getNext() {
+    return next;
+  }
+
+  /** Retrieves the next node of a read-only node, also read-only. */
+  const DLListNode<DataType> *getNext() const {
     return next;
   }
 
@@ -75,7 +113,7 @@ class DLListNode {
    * @param key The new value to store.
    */
   void setKey(DataType key) {
-    this->key = key;
+    this->key = std::move(key);
   }
 
   /**
@@ -105,18 +143,71 @@ class DLListNode {
  * @brief Implements all functions to create a doubly linked list. It is used
  * to correct collisions in the Hash Table.
  * @tparam DataType Type of data stored in the list nodes.
+ * @tparam Allocator Allocator of the nodes (see NodePool.hpp); by default
+ * nodes come from a pool owned by the list.
+ * @details The sentinel node is created on the first insertion, so an empty
+ * list does not allocate. The allocator is a private base, so a stateless one
+ * takes no space and the list is a single pointer, which is null when the
+ * list is empty. This keeps large arrays of buckets cheap to create.
  */
-template <typename DataType>
-class DLList {
+template <typename DataType, template <typename> class Allocator = NodePool>
+class DLList : private Allocator<DLListNode<DataType>> {
  public:
   /**
    * @brief Constructor.
-   * @details Initializes an empty list with a sentinel node.
+   * @details Initializes an empty list; the sentinel is created when needed.
    */
   DLList() {
-    nil = new DLListNode<DataType>();
-    nil->next = nil;
-    nil->prev = nil;
+    nil = nullptr;
+  }
+
+  /**
+   * @brief Copy constructor.
+   * @param other The list to copy; its nodes are copied in the same order.
+   */
+  DLList(const DLList &other) : Allocator<DLListNode<DataType>>() {
+    nil = nullptr;
+    if (other.nil == nullptr) return;
+    for (DLListNode<DataType> *node = other.nil->prev; node != other.nil;
+      node = node->prev) {
+      insert(node->key);
+    }
+  }
+
+  /**
+   * @brief Move constructor.
+   * @param other The list whose nodes are taken; it is left empty.
+   */
+  DLList(DLList &&other) noexcept
+    : Allocator<DLListNode<DataType>>(std::move(other.getAllocator())) {
+    nil = other.nil;
+    other.nil = nullptr;
+  }
+
+  /**
+   * @brief Copy assignment.
+   * @param other The list to copy.
+   * @return This list.
+   */
+  DLList &operator=(const DLList &other) {
+    if (this != &other) {
+      DLList copy(other);
+      std::swap(nil, copy.nil);
+      std::swap(getAllocator(), copy.getAllocator());
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment.
+   * @param other The list whose nodes are taken; it receives the old nodes
+   * of this list and deletes them when destroyed.
+   * @return This list.
+   */
+  DLList &operator=(DLList &&other) noexcept {
+    std::swap(nil, other.nil);
+    std::swap(getAllocator(), other.getAllocator());
+    return *this;
   }
 
   /**
@@ -133,19 +224,68 @@ class DLList {
    * @param value The value to insert.
    */
   void insert(const DataType &value) {
-    DLListNode<DataType> *newNode = new DLListNode<DataType>(value, nil->next,
-      nil);
-    nil->next->prev = newNode;
-    nil->next = newNode;
+    pushFront(getAllocator().create(value));
+  }
+
+  /**
+   * @brief Inserts a value at the beginning of the list, moving it into the
+   * node.
+   * @param value The value to insert.
+   */
+  void insert(DataType &&value) {
+    emplace(std::move(value));
+  }
+
+  /**
+   * @brief Inserts at the beginning of the list a value built in place.
+   * @param args The arguments of the value's constructor.
+   * @return Pointer to the new node.
+   */
+  template <typename... Args>
+  DLListNode<DataType> *emplace(Args &&...args) {
+    DLListNode<DataType> *node =
+      getAllocator().create(std::in_place, std::forward<Args>(args)...);
+    pushFront(node);
+    return node;
+  }
+
+  /**
+   * @brief Inserts at the beginning of the list a value built in place from
+   * a key and the arguments of the mapped value, unless the key is already in
+   * the list.
+   * @param key The key, which is only copied or moved if it is inserted.
+   * @param args The arguments of the mapped value's constructor.
+   * @return The node with the key, and whether it was inserted.
+   */
+  template <typename Key, typename... Args>
+  std::pair<DLListNode<DataType> *, bool> try_emplace(Key &&key,
+    Args &&...args) {
+    DLListNode<DataType> *node = search(key);
+    if (node != nullptr) return {node, false};
+    return {emplace(std::forward<Key>(key), std::forward<Args>(args)...),
+      true};
   }
 
   /**
    * @brief Searches for a value in the list.
-   * @param value The value to search for.
+   * @param value The value to search for; a bare key in a map.
    * @return Pointer to the node containing the value, or nullptr if not found.
    */
-  DLListNode<DataType> *search(const DataType &value) const {
-    DLListNode<DataType> *current = nil->next;
+  template <typename Key>
+  DLListNode<DataType> *search(const Key &value) {
+    return const_cast<DLListNode<DataType> *>(std::as_const(*this).search(
+      value));
+  }
+
+  /**
+   * @brief Searches a read-only list, whose values cannot be modified.
+   * @param value The value to search for; a bare key in a map.
+   * @return Pointer to the node containing the value, or nullptr if not found.
+   */
+  template <typename Key>
+  const DLListNode<DataType> *search(const Key &value) const {
+    if (nil == nullptr) return nullptr;
+    const DLListNode<DataType> *current = nil->next;
     while (current != nil && current->key != value) {
       current = current->next;
     }
@@ -154,9 +294,10 @@ class DLList {
 
   /**
    * @brief Removes a node with a specified value from the list.
-   * @param value The value of the node to remove.
+   * @param value The value of the node to remove; a bare key in a map.
    */
-  void remove(const DataType &value) {
+  template <typename Key>
+  void remove(const Key &value) {
     DLListNode<DataType> *node = search(value);
     if (node != nullptr) {
       remove(node);
@@ -168,18 +309,32 @@ class DLList {
    * @param node Pointer to the node to remove.
    */
   void remove(DLListNode<DataType> *node) {
-    if (node != nil) {
+    if (node != nullptr && node != nil) {
       node->prev->next = node->next;
       node->next->prev = node->prev;
-      delete node;
+      getAllocator().destroy(node);
     }
   }
 
+  /**
+   * @brief Checks whether the list has no nodes.
+   * @return True if the list is empty.
+   */
+  bool isEmpty() const {
+    return nil == nullptr || nil->next == nil;
+  }
+
   /**
    * @brief Retrieves the sentinel node.
-   * @return Pointer to the sentinel node.
+   * @return Pointer to the sentinel node, or nullptr if nothing has ever been
+   * inserted in the list.
    */
-  DLListNode<DataType> *getNil() const {
+  DLListNode<DataType> *getNil() {
+    return nil;
+  }
+
+  /** Retrieves the sentinel node of a read-only list. */
+  const DLListNode<DataType> *getNil() const {
     return nil;
   }
 
@@ -187,18 +342,76 @@ class DLList {
   /** Sentinel node to ease list operations. */
   DLListNode<DataType> *nil;
 
-  /** Removes all nodes from the list. */
+  /** Retrieves the allocator of the nodes, which is the base of the list. */
+  Allocator<DLListNode<DataType>> &getAllocator() {
+    return *this;
+  }
+
+  /**
+   * @brief Removes all nodes from the list.
+   * @details If the allocator frees its nodes in bulk and the keys need no
+   * destructor, the nodes are not visited.
+   */
   void clear() {
-    DLListNode<DataType> *current = nil->next;
-    while (current != nil) {
-      DLListNode<DataType> *toDelete = current;
-      current = current->next;
-      delete toDelete;
+    if (nil == nullptr) return;
+    if constexpr (!Allocator<DLListNode<DataType>>::kBulkRelease ||
+      !std::is_trivially_destructible_v<DataType>) {
+      DLListNode<DataType> *current = nil->next;
+      while (current != nil) {
+        DLListNode<DataType> *toDelete = current;
+        current = current->next;
+        getAllocator().destroy(toDelete);
+      }
     }
+    getAllocator().release();
     nil->next = nil;
     nil->prev = nil;
   }
 
-  template <typename T>
+  /** Removes all nodes and deletes the sentinel, leaving no allocations. */
+  void reset() {
+    clear();
+    delete nil;
+    nil = nullptr;
+  }
+
+  /**
+   * @brief Links an existing node at the beginning of the list.
+   * @param node The node to link; the list takes ownership of it.
+   */
+  void pushFront(DLListNode<DataType> *node) {
+    if (nil == nullptr) {
+      nil = new DLListNode<DataType>();
+      nil->next = nil;
+      nil->prev = nil;
+    }
+    node->next = nil->next;
+    node->prev = nil;
+    nil->next->prev = node;
+    nil->next = node;
+  }
+
+  /**
+   * @brief Unlinks the first node without deleting it.
+   * @return The unlinked node, owned by the caller, or nullptr if the list
+   * is empty.
+   */
+  DLListNode<DataType> *popFront() {
+    if (isEmpty()) return nullptr;
+    DLListNode<DataType> *node = nil->next;
+    nil->next = node->next;
+    node->next->prev = nil;
+    return node;
+  }
+
+  /** The hash table moves nodes between buckets that use new and delete. */
+  template <typename T, typename Hasher>
   friend class ChainedHashTable;
 };
+
+/**
+ * @brief Doubly linked list of keys with mapped values (see KeyValuePair.hpp).
+ */
+template <typename Key, typename Value,
+  template <typename> class Allocator = NodePool>
+using DLListMap = DLList<KeyValuePair<Key, Value>, Allocator>;
@@ -0,0 +1,213 @@
+/*
+ * Credits
+ * Based on: Prof. Arturo Camacho, Universidad de Costa Rica
+ * Template provided by: Prof. Allan Berrocal Rojas
+ * Adapted by: Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class EpochReclamation
+ * @brief Epoch-based memory reclamation shared by the concurrent structures.
+ * @details A thread pins itself (with a Guard) before reading shared nodes
+ * and unpins when it no longer holds any pointer to them. A node that has
+ * been unlinked is retired instead of deleted; it is deleted once the global
+ * epoch has advanced twice since it was retired, because by then every
+ * thread that could have seen it has unpinned. The epoch only advances when
+ * every pinned thread has observed the current epoch. Pinning and unpinning
+ * are a couple of stores, so readers never wait. There is one process-wide
+ * instance, so a thread registers only once no matter how many structures it
+ * uses.
+ */
+class EpochReclamation {
+ public:
+  /**
+   * @class Guard
+   * @brief Keeps the calling thread pinned while it is alive. Guards can be
+   * nested.
+   */
+  class Guard {
+   public:
+    Guard() {
+      EpochReclamation::instance().pin();
+    }
+
+    ~Guard() {
+      EpochReclamation::instance().unpin();
+    }
+
+    Guard(const Guard &) = delete;
+    Guard &operator=(const Guard &) = delete;
+  };
+
+  /**
+   * @brief Retrieves the process-wide instance.
+   * @return The instance.
+   */
+  static EpochReclamation &instance() {
+    static EpochReclamation domain;
+    return domain;
+  }
+
+  /**
+   * @brief Retires an object that is no longer reachable from the shared
+   * structure; it is deleted when no pinned thread can still be reading it.
+   * @param object The object to retire.
+   */
+  template <typename T>
+  void retire(T *object) {
+    retire(object, [](void *pointer) { delete static_cast<T *>(pointer); });
+  }
+
+  /**
+   * @brief Retires an object with a custom deleter.
+   * @param object The object to retire.
+   * @param deleter Function that deletes the object.
+   */
+  void retire(void *object, void (*deleter)(void *)) {
+    Record *record = localRecord();
+    record->limbo.push_back({object, deleter,
+      globalEpoch.load(std::memory_order_acquire)});
+    if (record->limbo.size() % kCollectInterval == 0) {
+      tryAdvance();
+      collect(record->limbo);
+      std::unique_lock<std::mutex> lock(orphansMutex, std::try_to_lock);
+      if (lock.owns_lock()) collect(orphans);
+    }
+  }
+
+  /** Deletes every object that is still retired. */
+  ~EpochReclamation() {
+    for (Record *record = records.load(); record != nullptr;) {
+      Record *next = record->next;
+      for (Retired &retired : record->limbo) retired.deleter(retired.object);
+      delete record;
+      record = next;
+    }
+    for (Retired &retired : orphans) retired.deleter(retired.object);
+  }
+
+ private:
+  /** Retires between attempts to advance the epoch and free objects. */
+  static constexpr size_t kCollectInterval = 64;
+
+  /** An object waiting to be deleted. */
+  struct Retired {
+    void *object;  /** The retired object. */
+    void (*deleter)(void *);  /** Function that deletes it. */
+    uint64_t epoch;  /** Global epoch when it was retired. */
+  };
+
+  /** State of a registered thread, on its own cache line. */
+  struct alignas(64) Record {
+    /** Epoch observed by the thread while pinned, 0 while not pinned. */
+    std::atomic<uint64_t> localEpoch{0};
+    std::atomic<bool> inUse{true};  /** Whether a thread owns the record. */
+    int nesting = 0;  /** Number of live guards of the owner thread. */
+    std::vector<Retired> limbo;  /** Objects retired by the owner thread. */
+    Record *next = nullptr;  /** Next record in the list of records. */
+  };
+
+  /** Releases the record of a thread when the thread exits. */
+  struct ThreadHandle {
+    Record *record = nullptr;
+
+    ~ThreadHandle() {
+      if (record != nullptr) EpochReclamation::instance().release(record);
+    }
+  };
+
+  /** Epochs start at 1 so that 0 can mean "not pinned". */
+  std::atomic<uint64_t> globalEpoch{1};
+  /** Records of all threads that ever registered; never shrinks. */
+  std::atomic<Record *> records{nullptr};
+  /** Objects retired by threads that have exited. */
+  std::vector<Retired> orphans;
+  std::mutex orphansMutex;  /** Protects orphans. */
+
+  EpochReclamation() = default;
+
+  /** Retrieves the record of the calling thread, registering it if needed. */
+  Record *localRecord() {
+    static thread_local ThreadHandle handle;
+    if (handle.record == nullptr) handle.record = acquire();
+    return handle.record;
+  }
+
+  /** Reuses the record of an exited thread or adds a new one. */
+  Record *acquire() {
+    for (Record *record = records.load(std::memory_order_acquire);
+      record != nullptr; record = record->next) {
+      bool free = false;
+      if (record->inUse.compare_exchange_strong(free, true)) return record;
+    }
+    Record *record = new Record();
+    record->next = records.load(std::memory_order_relaxed);
+    while (!records.compare_exchange_weak(record->next, record,
+      std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return record;
+  }
+
+  /** Hands the objects of an exiting thread over and frees its record. */
+  void release(Record *record) {
+    {
+      std::lock_guard<std::mutex> lock(orphansMutex);
+      orphans.insert(orphans.end(), record->limbo.begin(),
+        record->limbo.end());
+    }
+    record->limbo.clear();
+    record->nesting = 0;
+    record->localEpoch.store(0, std::memory_order_release);
+    record->inUse.store(false, std::memory_order_release);
+  }
+
+  /** Pins the calling thread to the current epoch. */
+  void pin() {
+    Record *record = localRecord();
+    if (record->nesting++ > 0) return;
+    record->localEpoch.store(globalEpoch.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+    /** The pin must be visible before any shared pointer is read. */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  /** Unpins the calling thread once its outermost guard ends. */
+  void unpin() {
+    Record *record = localRecord();
+    if (--record->nesting > 0) return;
+    record->localEpoch.store(0, std::memory_order_release);
+  }
+
+  /** Advances the global epoch if every pinned thread has observed it. */
+  void tryAdvance() {
+    uint64_t epoch = globalEpoch.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (Record *record = records.load(std::memory_order_acquire);
+      record != nullptr; record = record->next) {
+      uint64_t local = record->localEpoch.load(std::memory_order_acquire);
+      if (local != 0 && local != epoch) return;
+    }
+    globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+  }
+
+  /** Deletes the objects of a list that were retired two epochs ago. */
+  void collect(std::vector<Retired> &list) {
+    uint64_t epoch = globalEpoch.load(std::memory_order_acquire);
+    size_t kept = 0;
+    for (Retired &retired : list) {
+      if (retired.epoch + 2 <= epoch) {
+        retired.deleter(retired.object);
+      } else {
+        list[kept++] = retired;
+      }
+    }
+    list.resize(kept);
+  }
+};
@@ -0,0 +1,116 @@
+/*
+ * Credits
+ * Based on: Prof. Arturo Camacho, Universidad de Costa Rica
+ * Template provided by: Prof. Allan Berrocal Rojas
+ * Adapted by: Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+/**
+ * @class EytzingerIndex
+ * @brief Read-only sorted set stored in an array in Eytzinger (breadth-first)
+ * order, for fast membership and lower bound queries.
+ * @tparam DataType Type of data stored in the index.
+ * @details The array holds an implicit complete binary search tree: the root
+ * is at position 1 and the children of position k are at 2k and 2k + 1, so
+ * there are no pointers and the first levels share a few cache lines. A
+ * search descends with k = 2k + (keys[k] < value), which has no branch to
+ * mispredict, and prefetches the cache line of the descendants four levels
+ * below, so the misses of consecutive levels overlap. The lower bound is the
+ * last node where the search turned left, which is recovered from the bits
+ * of k at the end.
+ */
+template <typename DataType>
+class EytzingerIndex {
+ public:
+  /** Constructor of an empty index. */
+  EytzingerIndex() : keys(1) {}
+
+  /**
+   * @brief Constructor that builds the index from a sorted range.
+   * @param begin Iterator to the first value.
+   * @param end Iterator past the last value.
+   * @note The values must be in ascending order.
+   */
+  template <typename Iterator>
+  EytzingerIndex(Iterator begin, Iterator end)
+    : size(static_cast<size_t>(std::distance(begin, end))), keys(size + 1) {
+    fill(begin, 1);
+  }
+
+  /**
+   * @brief Checks whether a value is in the index.
+   * @param value The value to search for.
+   * @return True if the value is in the index.
+   */
+  bool contains(const DataType &value) const {
+    size_t k = lowerBoundIndex(value);
+    return k != 0 && keys[k] == value;
+  }
+
+  /**
+   * @brief Finds the first key that is not less than a value.
+   * @param value The value to compare with.
+   * @return Pointer to the key, or nullptr if every key is less than value.
+   */
+  const DataType *lower_bound(const DataType &value) const {
+    size_t k = lowerBoundIndex(value);
+    return k == 0 ? nullptr : &keys[k];
+  }
+
+  /**
+   * @brief Retrieves the number of keys in the index.
+   * @return The number of keys.
+   */
+  size_t getSize() const {
+    return size;
+  }
+
+ private:
+  /** Descendants four levels below a position, whose line is prefetched. */
+  static constexpr size_t kPrefetchStride = 16;
+
+  size_t size = 0;  /** Number of keys. */
+  /** Keys in Eytzinger order from position 1; position 0 is unused. */
+  std::vector<DataType> keys;
+
+  /**
+   * @brief Places the keys of a sorted range in the subtree of a position,
+   * by walking the subtree in order.
+   * @param it Iterator to the next key to place; it is advanced.
+   * @param k The position of the root of the subtree.
+   */
+  template <typename Iterator>
+  void fill(Iterator &it, size_t k) {
+    if (k > size) return;
+    fill(it, 2 * k);
+    keys[k] = *it;
+    ++it;
+    fill(it, 2 * k + 1);
+  }
+
+  /**
+   * @brief Finds the position of the first key that is not less than a
+   * value.
+   * @return The position, or 0 if every key is less than value.
+   */
+  size_t lowerBoundIndex(const DataType &value) const {
+    /** The address is computed as an integer because it may be past the end
+     * of the array; a prefetch of an invalid address does nothing. */
+    const uintptr_t base = reinterpret_cast<uintptr_t>(keys.data());
+    size_t k = 1;
+    while (k <= size) {
+      __builtin_prefetch(reinterpret_cast<const void *>(
+        base + kPrefetchStride * k * sizeof(DataType)));
+      k = 2 * k + static_cast<size_t>(keys[k] < value);
+    }
+    /** Drop the trailing right turns and the last left turn. */
+    k >>= __builtin_ffsll(static_cast<long long>(~k));
+    return k;
+  }
+};
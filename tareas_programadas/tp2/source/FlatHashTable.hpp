@@ -0,0 +1,260 @@
+/*
+ * Credits
+ * Based on: Prof. Arturo Camacho, Universidad de Costa Rica
+ * Template provided by: Prof. Allan Berrocal Rojas
+ * Adapted by: Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+ */
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @class FlatHashTable
+ * @brief Implements a hash set with open addressing in the SwissTable style.
+ * @tparam DataType Type of data stored in the hash table.
+ * @tparam Hash Function object that hashes a DataType.
+ * @details Keys live in one flat array of slots, next to an array with one
+ * control byte per slot. A control byte is either empty, deleted, or holds 7
+ * bits of the key's hash (h2). Slots are grouped 16 at a time: a lookup
+ * compares the 16 control bytes of a group against h2 with a single SSE2
+ * instruction and only touches the slots whose byte matched, so a miss
+ * usually reads one cache line of metadata and no keys at all. Groups are
+ * probed quadratically and the table grows once 7/8 of the slots are used.
+ * Removing a key from a group that still has an empty slot frees the slot
+ * outright; only removals from full groups leave a tombstone.
+ */
+template <typename DataType, typename Hash = std::hash<DataType>>
+class FlatHashTable {
+ public:
+  /**
+   * @brief Constructor that reserves room for a number of keys.
+   * @param size The number of keys the table can hold without growing.
+   */
+  FlatHashTable(size_t size) {
+    rehash(groupsFor(size));
+  }
+
+  /** Destructor. */
+  ~FlatHashTable() {}
+
+  /**
+   * @brief Inserts a value into the hash table, avoiding duplicates.
+   * @param value The value to insert.
+   */
+  void insert(const DataType &value) {
+    size_t h = hash(value);
+    if (find(value, h) != kNotFound) return;  /** Avoid duplicates. */
+    if (growthLeft == 0) {
+      /** Reclaim tombstones if they are many, otherwise double the size. */
+      size_t groups = groupMask + 1;
+      rehash(count < maxLoad(groups) / 2 ? groups : 2 * groups);
+    }
+    size_t slot = findFreeSlot(h);
+    if (control[slot] == kEmpty) {
+      --growthLeft;
+    } else {
+      --tombstones;
+    }
+    control[slot] = h2(h);
+    slots[slot] = value;
+    ++count;
+  }
+
+  /**
+   * @brief Searches for a value in the hash table.
+   * @param value The value to search for.
+   * @return Pointer to the stored value, or nullptr if not found.
+   */
+  const DataType *search(const DataType &value) const {
+    size_t slot = find(value, hash(value));
+    return slot == kNotFound ? nullptr : &slots[slot];
+  }
+
+  /**
+   * @brief Removes a value from the hash table.
+   * @param value The value to remove.
+   * @details If the value's group still has an empty slot, no probe sequence
+   * has ever continued past that group, so the slot can be marked empty
+   * instead of leaving a tombstone.
+   */
+  void remove(const DataType &value) {
+    size_t slot = find(value, hash(value));
+    if (slot == kNotFound) return;
+    const int8_t *group = &control[slot & ~(kGroupWidth - 1)];
+    if (match(group, kEmpty) != 0) {
+      control[slot] = kEmpty;
+      ++growthLeft;
+    } else {
+      control[slot] = kDeleted;
+      ++tombstones;
+    }
+    --count;
+  }
+
+  /**
+   * @brief Retrieves the number of slots in the hash table.
+   * @return The number of slots.
+   */
+  size_t getSize() const {
+    return slots.size();
+  }
+
+  /**
+   * @brief Retrieves the number of keys stored in the hash table.
+   * @return The number of keys.
+   */
+  size_t getCount() const {
+    return count;
+  }
+
+ private:
+  static constexpr size_t kGroupWidth = 16;  /** Slots probed at once. */
+  static constexpr int8_t kEmpty = -128;  /** Control byte of empty slots. */
+  static constexpr int8_t kDeleted = -2;  /** Control byte of tombstones. */
+  static constexpr size_t kNotFound = ~size_t(0);  /** Missing slot. */
+
+  std::vector<int8_t> control;  /** One control byte per slot. */
+  std::vector<DataType> slots;  /** Keys, aligned with the control bytes. */
+  size_t groupMask = 0;  /** Number of groups minus one (a power of two). */
+  size_t count = 0;  /** Number of keys stored. */
+  size_t tombstones = 0;  /** Number of deleted slots. */
+  size_t growthLeft = 0;  /** Empty slots usable before growing. */
+  Hash hasher;  /** Hash function for the keys. */
+
+  /**
+   * @brief Hash function that mixes the bits of the key's hash.
+   * @param key The key to hash.
+   * @return The mixed hash; its low 7 bits are h2 and the rest pick a group.
+   * @details Uses the 64-bit finalizer of MurmurHash3, because std::hash is
+   * the identity for integers and h2 needs well distributed bits.
+   */
+  size_t hash(const DataType &key) const {
+    uint64_t h = static_cast<uint64_t>(hasher(key));
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+  }
+
+  /** Returns the 7 hash bits stored in the control byte. */
+  static int8_t h2(size_t h) {
+    return static_cast<int8_t>(h & 0x7F);
+  }
+
+  /** Returns the group where the probe sequence of a hash starts. */
+  size_t firstGroup(size_t h) const {
+    return (h >> 7) & groupMask;
+  }
+
+  /** Returns the number of keys that fit in a number of groups. */
+  static size_t maxLoad(size_t groups) {
+    return groups * kGroupWidth / 8 * 7;
+  }
+
+  /** Returns the smallest power of two number of groups that fits n keys. */
+  static size_t groupsFor(size_t n) {
+    size_t groups = 1;
+    while (maxLoad(groups) < n) groups *= 2;
+    return groups;
+  }
+
+  /**
+   * @brief Compares the 16 control bytes of a group with a byte.
+   * @return A bit mask with bit i set if the i-th byte equals 'byte'.
+   */
+  static uint32_t match(const int8_t *group, int8_t byte) {
+#ifdef __SSE2__
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+    return static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(byte))));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupWidth; ++i) {
+      if (group[i] == byte) mask |= uint32_t(1) << i;
+    }
+    return mask;
+#endif
+  }
+
+  /**
+   * @brief Finds the empty and deleted slots of a group. Both control bytes
+   * have the high bit set, unlike the h2 of full slots.
+   * @return A bit mask with bit i set if the i-th slot is free.
+   */
+  static uint32_t matchFree(const int8_t *group) {
+#ifdef __SSE2__
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(bytes));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupWidth; ++i) {
+      if (group[i] < 0) mask |= uint32_t(1) << i;
+    }
+    return mask;
+#endif
+  }
+
+  /**
+   * @brief Finds the slot that holds a value.
+   * @param value The value to search for.
+   * @param h The hash of the value.
+   * @return The index of the slot, or kNotFound.
+   */
+  size_t find(const DataType &value, size_t h) const {
+    size_t group = firstGroup(h);
+    int8_t tag = h2(h);
+    for (size_t step = 1; ; ++step) {
+      const int8_t *bytes = &control[group * kGroupWidth];
+      for (uint32_t bits = match(bytes, tag); bits != 0; bits &= bits - 1) {
+        size_t slot = group * kGroupWidth + __builtin_ctz(bits);
+        if (slots[slot] == value) return slot;
+      }
+      /** An empty slot ends the probe sequence. */
+      if (match(bytes, kEmpty) != 0) return kNotFound;
+      group = (group + step) & groupMask;
+    }
+  }
+
+  /**
+   * @brief Finds the first empty or deleted slot in the probe sequence of a
+   * hash. The table always keeps at least one empty slot, so this ends.
+   */
+  size_t findFreeSlot(size_t h) const {
+    size_t group = firstGroup(h);
+    for (size_t step = 1; ; ++step) {
+      uint32_t bits = matchFree(&control[group * kGroupWidth]);
+      if (bits != 0) return group * kGroupWidth + __builtin_ctz(bits);
+      group = (group + step) & groupMask;
+    }
+  }
+
+  /**
+   * @brief Moves every key into a new table with the given number of groups,
+   * dropping all tombstones.
+   */
+  void rehash(size_t groups) {
+    std::vector<int8_t> oldControl(groups * kGroupWidth, kEmpty);
+    std::vector<DataType> oldSlots(groups * kGroupWidth);
+    oldControl.swap(control);
+    oldSlots.swap(slots);
+    groupMask = groups - 1;
+    tombstones = 0;
+    growthLeft = maxLoad(groups) - count;
+    for (size_t i = 0; i < oldControl.size(); ++i) {
+      if (oldControl[i] < 0) continue;  /** Skip empty and deleted slots. */
+      size_t h = hash(oldSlots[i]);
+      size_t slot = findFreeSlot(h);
+      control[slot] = h2(h);
+      slots[slot] = std::move(oldSlots[i]);
+    }
+  }
+};
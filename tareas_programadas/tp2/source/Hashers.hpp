@@ -0,0 +1,224 @@
+/*
+ * Credits
+ * Based on: Prof. Arturo Camacho, Universidad de Costa Rica
+ * Template provided by: Prof. Allan Berrocal Rojas
+ * Adapted by: Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Hasher policies for ChainedHashTable. A policy is a function object that
+ * maps a key and a number of buckets to a bucket index, and declares with
+ * kPowerOfTwo whether the table must keep its number of buckets a power of
+ * two.
+ */
+
+/**
+ * @class ModuloHash
+ * @brief Baseline hasher for integral keys: h(k) = k % m.
+ * @details Needs an integer division per lookup and maps keys that share a
+ * stride with m, such as multiples of m, to the same bucket.
+ */
+struct ModuloHash {
+  static constexpr bool kPowerOfTwo = false;
+
+  template <typename Key>
+  size_t operator()(const Key &key, size_t buckets) const {
+    return static_cast<size_t>(key) % buckets;
+  }
+};
+
+/**
+ * @class FibonacciHash
+ * @brief Multiplicative hasher for integral keys with power of two sizes.
+ * @details Multiplies the key by 2^64 divided by the golden ratio and keeps
+ * the top lg(m) bits of the product, which depend on every bit of the key.
+ */
+struct FibonacciHash {
+  static constexpr bool kPowerOfTwo = true;
+
+  template <typename Key>
+  size_t operator()(const Key &key, size_t buckets) const {
+    if (buckets <= 1) return 0;
+    uint64_t product = static_cast<uint64_t>(key) * 0x9e3779b97f4a7c15ULL;
+    return static_cast<size_t>(product >> (64 - __builtin_ctzll(buckets)));
+  }
+};
+
+/**
+ * @brief Mixes the bits of a 64-bit value with the MurmurHash3 finalizer.
+ */
+inline uint64_t mixBits(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+/**
+ * @brief Maps a 64-bit hash to [0, buckets) with Lemire's fastrange: the
+ * high half of hash * buckets. It replaces the division with a
+ * multiplication, but only spreads keys if the hash uses all 64 bits.
+ */
+inline size_t fastRange(uint64_t hash, size_t buckets) {
+  return static_cast<size_t>(
+    (static_cast<unsigned __int128>(hash) * buckets) >> 64);
+}
+
+/**
+ * @class FastRangeHash
+ * @brief Hasher for integral keys that mixes the key and reduces it with
+ * fastrange, so it works with any number of buckets without a division.
+ */
+struct FastRangeHash {
+  static constexpr bool kPowerOfTwo = false;
+
+  template <typename Key>
+  size_t operator()(const Key &key, size_t buckets) const {
+    return fastRange(mixBits(static_cast<uint64_t>(key)), buckets);
+  }
+};
+
+/**
+ * @class WyHash
+ * @brief Seeded hasher in the style of wyhash for strings and composite
+ * keys, reduced with fastrange.
+ * @details Strings are hashed 16 or 48 bytes at a time with 64x64 to 128-bit
+ * multiplications. Pairs combine the hashes of their members, and any other
+ * type is hashed through its bytes, which requires a type without padding
+ * (std::has_unique_object_representations). A random seed keeps an
+ * adversary from choosing keys that collide.
+ */
+class WyHash {
+ public:
+  static constexpr bool kPowerOfTwo = false;
+
+  /**
+   * @brief Constructor.
+   * @param seed The seed mixed into every hash.
+   */
+  explicit WyHash(uint64_t seed = 0x2d358dccaa6c78a5ULL) : seed(seed) {}
+
+  template <typename Key>
+  size_t operator()(const Key &key, size_t buckets) const {
+    return fastRange(hashValue(key), buckets);
+  }
+
+  /** Hashes the characters of a string. */
+  uint64_t hashValue(std::string_view key) const {
+    return hashBytes(key.data(), key.size());
+  }
+
+  /** Hashes the characters of a string. */
+  uint64_t hashValue(const std::string &key) const {
+    return hashBytes(key.data(), key.size());
+  }
+
+  /** Hashes a pair by combining the hashes of its members. */
+  template <typename First, typename Second>
+  uint64_t hashValue(const std::pair<First, Second> &key) const {
+    return mix(hashValue(key.first) ^ kSecret[0],
+      hashValue(key.second) ^ seed);
+  }
+
+  /** Hashes any other key through its bytes. */
+  template <typename Key>
+  uint64_t hashValue(const Key &key) const {
+    static_assert(std::has_unique_object_representations_v<Key>,
+      "WyHash can only hash the bytes of types without padding.");
+    return hashBytes(&key, sizeof(Key));
+  }
+
+ private:
+  /** Constants of wyhash. */
+  static constexpr uint64_t kSecret[4] = {0xa0761d6478bd642fULL,
+    0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL};
+
+  uint64_t seed;  /** Seed of the hasher. */
+
+  /** Multiplies two 64-bit values and folds the 128-bit product. */
+  static uint64_t mix(uint64_t a, uint64_t b) {
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<uint64_t>(product) ^
+      static_cast<uint64_t>(product >> 64);
+  }
+
+  /** Reads 8 bytes. */
+  static uint64_t read8(const uint8_t *p) {
+    uint64_t value;
+    std::memcpy(&value, p, 8);
+    return value;
+  }
+
+  /** Reads 4 bytes. */
+  static uint64_t read4(const uint8_t *p) {
+    uint32_t value;
+    std::memcpy(&value, p, 4);
+    return value;
+  }
+
+  /** Reads 1 to 3 bytes. */
+  static uint64_t read3(const uint8_t *p, size_t length) {
+    return (static_cast<uint64_t>(p[0]) << 16) |
+      (static_cast<uint64_t>(p[length >> 1]) << 8) | p[length - 1];
+  }
+
+  /**
+   * @brief Hashes a sequence of bytes.
+   * @param data The first byte.
+   * @param length The number of bytes.
+   * @return A 64-bit hash.
+   */
+  uint64_t hashBytes(const void *data, size_t length) const {
+    const uint8_t *p = static_cast<const uint8_t *>(data);
+    uint64_t state = seed ^ mix(seed ^ kSecret[0], kSecret[1]);
+    uint64_t a = 0;
+    uint64_t b = 0;
+    if (length <= 16) {
+      if (length >= 4) {
+        size_t offset = (length >> 3) << 2;
+        a = (read4(p) << 32) | read4(p + offset);
+        b = (read4(p + length - 4) << 32) | read4(p + length - 4 - offset);
+      } else if (length > 0) {
+        a = read3(p, length);
+      }
+    } else {
+      size_t left = length;
+      if (left > 48) {
+        uint64_t state1 = state;
+        uint64_t state2 = state;
+        do {
+          state = mix(read8(p) ^ kSecret[1], read8(p + 8) ^ state);
+          state1 = mix(read8(p + 16) ^ kSecret[2], read8(p + 24) ^ state1);
+          state2 = mix(read8(p + 32) ^ kSecret[3], read8(p + 40) ^ state2);
+          p += 48;
+          left -= 48;
+        } while (left > 48);
+        state ^= state1 ^ state2;
+      }
+      while (left > 16) {
+        state = mix(read8(p) ^ kSecret[1], read8(p + 8) ^ state);
+        p += 16;
+        left -= 16;
+      }
+      a = read8(p + left - 16);
+      b = read8(p + left - 8);
+    }
+    a ^= kSecret[1];
+    b ^= state;
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    a = static_cast<uint64_t>(product);
+    b = static_cast<uint64_t>(product >> 64);
+    return mix(a ^ kSecret[0] ^ length, b ^ kSecret[1]);
+  }
+};
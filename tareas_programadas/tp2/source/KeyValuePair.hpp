@@ -0,0 +1,102 @@
+/*
+ * Credits
+ * Based on: Prof. Arturo Camacho, Universidad de Costa Rica
+ * Template provided by: Prof. Allan Berrocal Rojas
+ * Adapted by: Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+ */
+
+#pragma once
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class KeyValuePair
+ * @brief A key with a mapped value, compared only by its key, which turns the
+ * set containers into maps (SLListMap, DLListMap, BSTreeMap, RBTreeMap,
+ * SplayTreeMap and ChainedHashMap).
+ * @tparam Key Type of the key.
+ * @tparam Value Type of the mapped value; it may be move-only.
+ * @details A pair can be compared with another pair or with a bare key, so
+ * the containers' search() and remove() take just the key. The key decides
+ * where the element is, so the nodes only hand out a const reference to the
+ * whole pair with getKey(). The value is updated in place through getValue()
+ * of a non-const node, which only a non-const container returns; a const
+ * container returns const nodes, whose values are read-only too.
+ */
+template <typename Key, typename Value>
+struct KeyValuePair {
+  Key key;  /** The key that orders and identifies the pair. */
+  Value value;  /** The mapped value. */
+
+  /** Default constructor; used for the sentinels of the containers. */
+  KeyValuePair() = default;
+
+  /**
+   * @brief Constructs the key from one argument and the value in place from
+   * the rest.
+   * @param key The key, copied or moved.
+   * @param args The arguments of the value's constructor.
+   */
+  template <typename K, typename... Args,
+    typename = std::enable_if_t<std::is_constructible_v<Key, K &&>>>
+  KeyValuePair(K &&key, Args &&...args)
+    : key(std::forward<K>(key)), value(std::forward<Args>(args)...) {}
+
+  friend bool operator<(const KeyValuePair &a, const KeyValuePair &b) {
+    return a.key < b.key;
+  }
+  friend bool operator<(const KeyValuePair &a, const Key &b) {
+    return a.key < b;
+  }
+  friend bool operator<(const Key &a, const KeyValuePair &b) {
+    return a < b.key;
+  }
+  friend bool operator>(const KeyValuePair &a, const KeyValuePair &b) {
+    return b.key < a.key;
+  }
+  friend bool operator>(const KeyValuePair &a, const Key &b) {
+    return b < a.key;
+  }
+  friend bool operator>(const Key &a, const KeyValuePair &b) {
+    return b.key < a;
+  }
+  friend bool operator==(const KeyValuePair &a, const KeyValuePair &b) {
+    return a.key == b.key;
+  }
+  friend bool operator==(const KeyValuePair &a, const Key &b) {
+    return a.key == b;
+  }
+  friend bool operator==(const Key &a, const KeyValuePair &b) {
+    return a == b.key;
+  }
+  friend bool operator!=(const KeyValuePair &a, const KeyValuePair &b) {
+    return !(a.key == b.key);
+  }
+  friend bool operator!=(const KeyValuePair &a, const Key &b) {
+    return !(a.key == b);
+  }
+  friend bool operator!=(const Key &a, const KeyValuePair &b) {
+    return !(a == b.key);
+  }
+
+  /** Prints the pair as "key: value", for the walks of the trees. */
+  friend std::ostream &operator<<(std::ostream &out,
+    const KeyValuePair &pair) {
+    return out << pair.key << ": " << pair.value;
+  }
+};
+
+/**
+ * @brief Retrieves the part of an element that identifies it: the element
+ * itself in a set, or the key of a KeyValuePair. The hash table hashes it.
+ */
+template <typename DataType>
+const DataType &keyOf(const DataType &value) {
+  return value;
+}
+
+template <typename Key, typename Value>
+const Key &keyOf(const KeyValuePair<Key, Value> &pair) {
+  return pair.key;
+}
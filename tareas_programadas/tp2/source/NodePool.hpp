@@ -0,0 +1,176 @@
+/*
+ * Credits
+ * Based on: Prof. Arturo Camacho, Universidad de Costa Rica
+ * Template provided by: Prof. Allan Berrocal Rojas
+ * Adapted by: Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+ */
+
+#pragma once
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * Node allocators for the lists and trees. An allocator is a class template
+ * over the node type that provides create() to construct a node, destroy()
+ * to destroy one, and release() to free every node at once, and declares
+ * with kBulkRelease whether release() actually frees the nodes. A container
+ * whose allocator releases in bulk and whose keys need no destructor can
+ * clear itself without visiting its nodes.
+ */
+
+/**
+ * @class NodePool
+ * @brief Slab allocator that hands out nodes from contiguous chunks.
+ * @tparam Node Type of the nodes.
+ * @details Chunks start with 32 nodes and double up to 65536 nodes, so nodes
+ * that are inserted together end up next to each other in memory. Chunks are
+ * aligned as Node requires, even for nodes aligned to the cache line.
+ * Destroyed nodes go to a free list and are reused before taking new slots.
+ * A pool belongs to one container; it can be moved with it but not copied.
+ */
+template <typename Node>
+class NodePool {
+ public:
+  static constexpr bool kBulkRelease = true;
+
+  /** Constructor. No memory is reserved until the first node. */
+  NodePool() = default;
+
+  /** Destructor. Frees every chunk. */
+  ~NodePool() {
+    release();
+  }
+
+  /** The nodes belong to one container, so a pool cannot be copied. */
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+
+  /**
+   * @brief Move constructor.
+   * @param other The pool whose chunks are taken; it is left empty.
+   */
+  NodePool(NodePool &&other) noexcept {
+    swap(other);
+  }
+
+  /**
+   * @brief Move assignment.
+   * @param other The pool to exchange chunks with.
+   * @return This pool.
+   */
+  NodePool &operator=(NodePool &&other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  /**
+   * @brief Constructs a node in a free slot.
+   * @param args The arguments of the node's constructor.
+   * @return Pointer to the new node.
+   */
+  template <typename... Args>
+  Node *create(Args &&...args) {
+    Slot *slot;
+    if (freeList != nullptr) {
+      slot = freeList;
+      freeList = freeList->next;
+    } else {
+      if (next == end) grow();
+      slot = next++;
+    }
+    return new (slot->storage) Node(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Destroys a node and puts its slot in the free list.
+   * @param node The node, which must have been created by this pool.
+   */
+  void destroy(Node *node) {
+    node->~Node();
+    Slot *slot = reinterpret_cast<Slot *>(node);
+    slot->next = freeList;
+    freeList = slot;
+  }
+
+  /**
+   * @brief Frees every chunk at once. Nodes still alive are not destroyed,
+   * so keys with a destructor must be destroyed first with destroy().
+   */
+  void release() {
+    for (Slot *chunk : chunks) {
+      ::operator delete(chunk, std::align_val_t{alignof(Slot)});
+    }
+    chunks.clear();
+    freeList = nullptr;
+    next = nullptr;
+    end = nullptr;
+    chunkSize = kFirstChunk;
+  }
+
+ private:
+  static constexpr size_t kFirstChunk = 32;  /** Nodes of the first chunk. */
+  static constexpr size_t kMaxChunk = 65536;  /** Nodes of largest chunks. */
+
+  /** Storage for a node, or a link of the free list when it is free. */
+  union Slot {
+    Slot *next;
+    alignas(Node) unsigned char storage[sizeof(Node)];
+  };
+
+  std::vector<Slot *> chunks;  /** Chunks reserved by the pool. */
+  Slot *freeList = nullptr;  /** First destroyed slot to reuse. */
+  Slot *next = nullptr;  /** Next never used slot of the last chunk. */
+  Slot *end = nullptr;  /** End of the last chunk. */
+  size_t chunkSize = kFirstChunk;  /** Nodes of the next chunk. */
+
+  /**
+   * Reserves a new chunk, aligned for the node type: nodes aligned to the
+   * cache line need more than the 16 bytes that plain operator new gives.
+   */
+  void grow() {
+    Slot *chunk = static_cast<Slot *>(::operator new(chunkSize * sizeof(Slot),
+      std::align_val_t{alignof(Slot)}));
+    chunks.push_back(chunk);
+    next = chunk;
+    end = chunk + chunkSize;
+    if (chunkSize < kMaxChunk) chunkSize *= 2;
+  }
+
+  /** Exchanges the chunks of two pools. */
+  void swap(NodePool &other) noexcept {
+    chunks.swap(other.chunks);
+    std::swap(freeList, other.freeList);
+    std::swap(next, other.next);
+    std::swap(end, other.end);
+    std::swap(chunkSize, other.chunkSize);
+  }
+};
+
+/**
+ * @class NewDeleteAllocator
+ * @brief Allocator that creates each node with the global new and delete.
+ * @tparam Node Type of the nodes.
+ * @details It has no state, so nodes can move between containers that use
+ * it, as the buckets of ChainedHashTable do during a rehash.
+ */
+template <typename Node>
+class NewDeleteAllocator {
+ public:
+  static constexpr bool kBulkRelease = false;
+
+  /** Constructs a node with new. */
+  template <typename... Args>
+  Node *create(Args &&...args) {
+    return new Node(std::forward<Args>(args)...);
+  }
+
+  /** Destroys a node with delete. */
+  void destroy(Node *node) {
+    delete node;
+  }
+
+  /** Does nothing; every node is deleted by destroy(). */
+  void release() {}
+};
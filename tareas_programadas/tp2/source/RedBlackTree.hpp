@@ -6,23 +6,48 @@
  */
 
 #pragma once
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "EytzingerIndex.hpp"
+#include "KeyValuePair.hpp"
+#include "NodePool.hpp"
+#include "Snapshot.hpp"
 
 enum colors { RED, BLACK };
 
-template <typename DataType>
+template <typename DataType, template <typename> class Allocator,
+  bool OrderStatistics>
 class RBTree;
 
+/**
+ * @brief Size of the subtree rooted at a node, stored only in the nodes of
+ * trees with order statistics. The empty specialization takes no space in
+ * the node thanks to the empty base optimization.
+ */
+template <bool OrderStatistics>
+struct RBTreeSubtreeSize {};
+
+template <>
+struct RBTreeSubtreeSize<true> {
+  size_t size = 0;  /** Number of nodes in the subtree, 0 for the sentinel. */
+};
+
 /**
  * @class RBTreeNode
  * @brief A node class for a Red-Black Tree (RBT) containing a key of generic
  * data type, color, and pointers to its parent, left, and right children.
  *
  * @tparam DataType The data type of the node's key.
+ * @tparam OrderStatistics Whether the node stores the size of its subtree.
  */
-template <typename DataType>
-class RBTreeNode {
+template <typename DataType, bool OrderStatistics = false>
+class RBTreeNode : public RBTreeSubtreeSize<OrderStatistics> {
  public:
-  friend class RBTree<DataType>;
+  template <typename, template <typename> class, bool>
+  friend class RBTree;
 
   /** 
    * @brief Default constructor that initializes a black node with a default 
@@ -46,9 +71,9 @@ class RBTreeNode {
    * @param right Pointer to the right child node (default is nullptr).
    * @param color The color of the node, either RED or BLACK (default is RED).
    */
-  RBTreeNode(const DataType &key, RBTreeNode<DataType>* parent = nullptr,
-    RBTreeNode<DataType>* left = nullptr,
-      RBTreeNode<DataType>* right = nullptr, colors color = colors::RED) {
+  RBTreeNode(const DataType &key, RBTreeNode* parent = nullptr,
+    RBTreeNode* left = nullptr,
+      RBTreeNode* right = nullptr, colors color = colors::RED) {
     this->key = key;
     this->parent = parent;
     this->left = left;
@@ -56,24 +81,54 @@ class RBTreeNode {
     this->color = color;
   }
 
+  /**
+   * @brief Constructs a red node whose key is built in place, without links.
+   *
+   * @param args The arguments of the key's constructor.
+   */
+  template <typename... Args>
+  explicit RBTreeNode(std::in_place_t, Args &&...args)
+    : key(std::forward<Args>(args)...), parent(nullptr), left(nullptr),
+      right(nullptr), color(colors::RED) {}
+
   /** Destructor. */
   ~RBTreeNode() {}
 
   /**
    * @brief Retrieves the key stored in the node.
    *
-   * @return The key value.
+   * @return Reference to the key value.
    */
-  DataType getKey() const {
+  const DataType &getKey() const {
     return key;
   }
 
+  /**
+   * @brief Retrieves the mapped value, in a node of a map (see
+   * KeyValuePair.hpp).
+   *
+   * @return Reference to the value, which can be modified in place.
+   */
+  auto &getValue() {
+    return key.value;
+  }
+
+  /** Retrieves the mapped value of a read-only node. */
+  const auto &getValue() const {
+    return key.value;
+  }
+
   /**
    * @brief Retrieves the parent node.
    *
    * @return Pointer to the parent node.
    */
-  RBTreeNode<DataType> *getParent() const {
+  RBTreeNode *getParent() {
+    return parent;
+  }
+
+  /** Retrieves the parent of a read-only node, also read-only. */
+  const RBTreeNode *getParent() const {
     return parent;
   }
 
@@ -82,7 +137,12 @@ class RBTreeNode {
    *
    * @return Pointer to the left child node.
    */
-  RBTreeNode<DataType> *getLeft() const {
+  RBTreeNode *getLeft() {
+    return left;
+  }
+
+  /** Retrieves the left child of a read-only node, also read-only. */
+  const RBTreeNode *getLeft() const {
     return left;
   }
 
@@ -91,7 +151,12 @@ class RBTreeNode {
    *
    * @return Pointer to the right child node.
    */
-  RBTreeNode<DataType> *getRight() const {
+  RBTreeNode *getRight() {
+    return right;
+  }
+
+  /** Retrieves the right child of a read-only node, also read-only. */
+  const RBTreeNode *getRight() const {
     return right;
   }
 
@@ -101,7 +166,7 @@ class RBTreeNode {
    * @param key The new key value.
    */
   void setKey(DataType key) {
-    this->key = key;
+    this->key = std::move(key);
   }
 
   /**
@@ -109,7 +174,7 @@ class RBTreeNode {
    *
    * @param parent Pointer to the new parent node.
    */
-  void setParent(RBTreeNode<DataType> *parent) {
+  void setParent(RBTreeNode *parent) {
     this->parent = parent;
   }
 
@@ -118,7 +183,7 @@ class RBTreeNode {
    *
    * @param left Pointer to the new left child node.
    */
-  void setLeft(RBTreeNode<DataType> *left) {
+  void setLeft(RBTreeNode *left) {
     this->left = left;
   }
 
@@ -127,15 +192,15 @@ class RBTreeNode {
    *
    * @param right Pointer to the new right child node.
    */
-  void setRight(RBTreeNode<DataType> *right) {
+  void setRight(RBTreeNode *right) {
     this->right = right;
   }
 
  private:
   DataType key;  /** The key value stored in the node. */
-  RBTreeNode<DataType> *parent;  /** Pointer to the parent node. */
-  RBTreeNode<DataType> *left;  /** Pointer to the left child node. */
-  RBTreeNode<DataType> *right;  /** Pointer to the right child node. */
+  RBTreeNode *parent;  /** Pointer to the parent node. */
+  RBTreeNode *left;  /** Pointer to the left child node. */
+  RBTreeNode *right;  /** Pointer to the right child node. */
   enum colors color;  /** Color of the node, either red or black. */
 };
 
@@ -147,10 +212,104 @@ class RBTreeNode {
  * @details The RBTree class maintains balanced tree properties, ensuring
  * efficient insertions, deletions, and lookups.
  * @tparam DataType Type of data stored in each tree node.
+ * @tparam Allocator Allocator of the nodes (see NodePool.hpp); by default
+ * nodes come from a pool owned by the tree.
+ * @tparam OrderStatistics Whether each node stores the size of its subtree,
+ * which enables select(), rank(), countRange() and getSize() in O(log n).
+ * The sizes are kept up to date by insertions, removals and rotations; when
+ * disabled, the field and its updates are compiled out.
  */
-template <typename DataType>
+template <typename DataType, template <typename> class Allocator = NodePool,
+  bool OrderStatistics = false>
 class RBTree {
  public:
+  /** Type of the nodes of the tree. */
+  using Node = RBTreeNode<DataType, OrderStatistics>;
+
+  /**
+   * @class Iterator
+   * @brief Bidirectional iterator over the keys of the tree in ascending
+   * order.
+   *
+   * @details Moves through parent pointers, so it needs no stack; a whole
+   * traversal follows each edge twice. The end of the tree is the sentinel.
+   * Keys cannot be modified through the iterator, because that would break
+   * the order of the tree.
+   */
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = DataType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const DataType *;
+    using reference = const DataType &;
+
+    /** Default constructor; the iterator points to no tree. */
+    Iterator() = default;
+
+    reference operator*() const {
+      return node->key;
+    }
+
+    pointer operator->() const {
+      return &node->key;
+    }
+
+    /** Moves to the next key. */
+    Iterator &operator++() {
+      node = tree->getSuccessor(node);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    /** Moves to the previous key; from the end, to the largest key. */
+    Iterator &operator--() {
+      if (node == tree->nil) {
+        node = tree->getMaximum(tree->root);
+      } else {
+        node = tree->getPredecessor(node);
+      }
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator previous = *this;
+      --*this;
+      return previous;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return node == other.node;
+    }
+
+    bool operator!=(const Iterator &other) const {
+      return node != other.node;
+    }
+
+    /**
+     * @brief Retrieves the node the iterator points to.
+     *
+     * @return Pointer to the node, or the sentinel at the end.
+     */
+    const Node *getNode() const {
+      return node;
+    }
+
+   private:
+    friend class RBTree;
+
+    Iterator(const RBTree *tree, const Node *node)
+      : tree(tree), node(node) {}
+
+    const RBTree *tree = nullptr;  /** Tree being traversed. */
+    const Node *node = nullptr;  /** Current node. */
+  };
+
   /**
    * @brief Constructor.
    *
@@ -159,7 +318,7 @@ class RBTree {
    * an initially empty tree.
    */
   RBTree() {
-    nil = new RBTreeNode<DataType>();
+    nil = new Node();
     nil->color = BLACK;
     nil->left = nil->right = nil->parent = nullptr;
     root = nil;
@@ -186,14 +345,54 @@ class RBTree {
    * function exits early.
    */
   void insert(const DataType &value) {
+    try_emplace(value);
+  }
+
+  /**
+   * @brief Insertion function that moves the value into the node.
+   *
+   * @param value The value to insert.
+   * @note Duplicates are not allowed, as in insert(const DataType &).
+   */
+  void insert(DataType &&value) {
+    try_emplace(std::move(value));
+  }
+
+  /**
+   * @brief Inserts a value built in place from its constructor's arguments.
+   *
+   * @details The value is built before the search, to compare it, and then
+   * moved into the node.
+   * @param args The arguments of the value's constructor.
+   * @return The node with the value, and whether it was inserted.
+   */
+  template <typename... Args>
+  std::pair<Node *, bool> emplace(Args &&...args) {
+    return try_emplace(DataType(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Inserts a value built in place from a key and the arguments of
+   * the mapped value, unless the key is already in the tree.
+   *
+   * @param key The key, or a whole value; it is only copied or moved if it
+   * is inserted.
+   * @param args The arguments of the mapped value's constructor.
+   * @return The node with the key, and whether it was inserted.
+   */
+  template <typename Key, typename... Args>
+  std::pair<Node *, bool> try_emplace(Key &&key, Args &&...args) {
     /** Check if the value already exists to prevent duplicates. */
-    if (search(root, value) != nil) return;
-    RBTreeNode<DataType> *node = new RBTreeNode<DataType>
-      (value, nil, nil, nil, RED);
-    RBTreeNode<DataType> *y = nil;
-    RBTreeNode<DataType> *x = root;
+    Node *existing = search(root, key);
+    if (existing != nil) return {existing, false};
+    Node *node = allocator.create(std::in_place, std::forward<Key>(key),
+      std::forward<Args>(args)...);
+    if constexpr (OrderStatistics) node->size = 1;
+    Node *y = nil;
+    Node *x = root;
     while (x != nil) {
       y = x;
+      if constexpr (OrderStatistics) ++x->size;
       if (node->key < x->key)
         x = x->left;
       else
@@ -210,6 +409,7 @@ class RBTree {
     node->right = nil;
     node->color = RED;
     insertFixup(node);
+    return {node, true};
   }
 
   /**
@@ -217,24 +417,29 @@ class RBTree {
    *
    * @details Removes a node with the specified value from the tree, if it
    * exists, maintaining balance.
-   * @param value The value to remove.
+   * @param value The value to remove; a bare key in a map.
    * After removal, a fixup function is called if necessary to restore
    * red-black properties.
    */
-  void remove(const DataType &value) {
-    RBTreeNode<DataType> *nodeToDelete = search(root, value);
+  template <typename Key>
+  void remove(const Key &value) {
+    Node *nodeToDelete = search(root, value);
     if (nodeToDelete == nil) return;
-    RBTreeNode<DataType> *y = nodeToDelete;
-    RBTreeNode<DataType> *x;
+    Node *y = nodeToDelete;
+    Node *x;
     enum colors originalColor = y->color;
     if (nodeToDelete->left == nil) {
       x = nodeToDelete->right;
+      decreaseSizes(nodeToDelete->parent);
       transplant(nodeToDelete, nodeToDelete->right);
     } else if (nodeToDelete->right == nil) {
       x = nodeToDelete->left;
+      decreaseSizes(nodeToDelete->parent);
       transplant(nodeToDelete, nodeToDelete->left);
     } else {
       y = getMinimum(nodeToDelete->right);
+      /** 'y' leaves its place, which takes one node from its ancestors. */
+      decreaseSizes(y->parent);
       originalColor = y->color;
       x = y->right;
       if (y->parent == nodeToDelete) {
@@ -248,24 +453,65 @@ class RBTree {
       y->left = nodeToDelete->left;
       y->left->parent = y;
       y->color = nodeToDelete->color;
+      if constexpr (OrderStatistics) y->size = nodeToDelete->size;
     }
-    delete nodeToDelete;
+    allocator.destroy(nodeToDelete);
     if (originalColor == BLACK) removeFixup(x);
   }
 
+  /**
+   * @brief Replaces the contents of the tree with the values of a sorted
+   * range, building a perfectly balanced tree in linear time.
+   *
+   * @details Each subtree takes the middle value of its range as its root, so
+   * every level but the deepest is full. Nodes on the deepest level are red
+   * when it is incomplete and every other node is black, which gives every
+   * path to a leaf the same number of black nodes without any fixup. Nodes
+   * are created in preorder, so with the pool each node is next to its left
+   * child in memory.
+   * @param begin Iterator to the first value.
+   * @param end Iterator past the last value.
+   * @note The values must be in ascending order and without duplicates.
+   */
+  template <typename Iterator>
+  void buildFromSorted(Iterator begin, Iterator end) {
+    clear();
+    auto n = std::distance(begin, end);
+    /** Depth of the deepest level, which is full only if n + 1 is 2^k. */
+    size_t redDepth = 0;
+    while ((static_cast<size_t>(2) << redDepth) <= static_cast<size_t>(n) + 1) {
+      ++redDepth;
+    }
+    root = buildSubtree(begin, n, nil, 0, redDepth);
+  }
+
   /**
    * @brief Search function.
    *
    * @details Searches for a node with a specified value in a subtree rooted at
    * a given node.
    * @param rootOfSubtree The root of the subtree to search.
-   * @param value The value to search for.
+   * @param value The value to search for; a bare key in a map.
    * @return A pointer to the found node or the sentinel (nil) if not found.
    */
-  RBTreeNode<DataType> *search(const RBTreeNode<DataType> *rootOfSubtree,
-    const DataType &value) const {
-    RBTreeNode<DataType> *node = const_cast<RBTreeNode<DataType> *>
-      (rootOfSubtree);
+  template <typename Key>
+  Node *search(const Node *rootOfSubtree,
+    const Key &value) {
+    return const_cast<Node *>(std::as_const(*this).search(rootOfSubtree,
+      value));
+  }
+
+  /**
+   * @brief Searches a read-only tree, whose values cannot be modified.
+   *
+   * @param rootOfSubtree The root of the subtree to search.
+   * @param value The value to search for; a bare key in a map.
+   * @return A pointer to the found node or the sentinel (nil) if not found.
+   */
+  template <typename Key>
+  const Node *search(const Node *rootOfSubtree,
+    const Key &value) const {
+    const Node *node = rootOfSubtree;
     while (node != nil && node->key != value) {
       if (value < node->key)
         node = node->left;
@@ -275,6 +521,53 @@ class RBTree {
     return node;
   }
 
+  /**
+   * @brief Searches for many values, interleaving their lookups to overlap
+   * their cache misses.
+   *
+   * @details Up to kBatchWidth lookups descend the tree at the same time. Each
+   * step compares one value with a node that a previous step prefetched,
+   * prefetches the child and moves on to another lookup, so the misses of
+   * different lookups wait for memory at the same time instead of one after
+   * the other.
+   * @param keys The values to search for.
+   * @param n The number of values.
+   * @param results Receives, for each value, its node or the sentinel (nil).
+   */
+  void searchBatch(const DataType *keys, size_t n,
+    const Node **results) const {
+    const Node *nodes[kBatchWidth];  /** Node each lookup reads next. */
+    size_t indexes[kBatchWidth];  /** Position of each lookup in keys. */
+    size_t active = 0;
+    size_t next = 0;
+    for (; active < kBatchWidth && next < n; ++active, ++next) {
+      nodes[active] = root;
+      indexes[active] = next;
+    }
+    while (active > 0) {
+      for (size_t slot = 0; slot < active;) {
+        const Node *node = nodes[slot];
+        const DataType &value = keys[indexes[slot]];
+        if (node != nil && !(node->key == value)) {
+          node = value < node->key ? node->left : node->right;
+          __builtin_prefetch(node);
+          nodes[slot++] = node;
+          continue;
+        }
+        results[indexes[slot]] = node;
+        if (next < n) {
+          nodes[slot] = root;
+          indexes[slot++] = next++;
+        } else {
+          /** Fill the slot with the last lookup in flight. */
+          --active;
+          nodes[slot] = nodes[active];
+          indexes[slot] = indexes[active];
+        }
+      }
+    }
+  }
+
   /**
    * @brief Function to get maximum.
    *
@@ -283,13 +576,18 @@ class RBTree {
    * @param rootOfSubtree The root of the subtree.
    * @return A pointer to the node with the maximum value in the subtree.
    */
-  RBTreeNode<DataType> *getMaximum(const RBTreeNode<DataType>
+  const Node *getMaximum(const Node
     *rootOfSubtree) const {
-    RBTreeNode<DataType> *node = rootOfSubtree;
+    const Node *node = rootOfSubtree;
     while (node->right != nil) node = node->right;
     return node;
   }
 
+  /** Finds the maximum of a subtree of a tree that can be modified. */
+  Node *getMaximum(const Node *rootOfSubtree) {
+    return const_cast<Node *>(std::as_const(*this).getMaximum(rootOfSubtree));
+  }
+
   /**
    * @brief Function to get minimum.
    *
@@ -298,14 +596,18 @@ class RBTree {
    * @param rootOfSubtree The root of the subtree.
    * @return A pointer to the node with the minimum value in the subtree.
    */
-  RBTreeNode<DataType> *getMinimum(const RBTreeNode<DataType>
+  const Node *getMinimum(const Node
     *rootOfSubtree) const {
-    RBTreeNode<DataType> *node = const_cast<RBTreeNode<DataType> *>
-      (rootOfSubtree);
+    const Node *node = rootOfSubtree;
     while (node->left != nil) node = node->left;
     return node;
   }
 
+  /** Finds the minimum of a subtree of a tree that can be modified. */
+  Node *getMinimum(const Node *rootOfSubtree) {
+    return const_cast<Node *>(std::as_const(*this).getMinimum(rootOfSubtree));
+  }
+
   /**
    * @brief Function to get successor node.
    *
@@ -314,9 +616,9 @@ class RBTree {
    * @param node The node for which the successor is to be found.
    * @return A pointer to the successor node, or nil if no successor exists.
    */
-  RBTreeNode<DataType> *getSuccessor(const RBTreeNode<DataType> *node) const {
+  const Node *getSuccessor(const Node *node) const {
     if (node->right != nil) return getMinimum(node->right);
-    RBTreeNode<DataType> *y = node->parent;
+    const Node *y = node->parent;
     while (y != nil && node == y->right) {
       node = y;
       y = y->parent;
@@ -324,13 +626,232 @@ class RBTree {
     return y;
   }
 
+  /** Finds the successor of a node of a tree that can be modified. */
+  Node *getSuccessor(const Node *node) {
+    return const_cast<Node *>(std::as_const(*this).getSuccessor(node));
+  }
+
+  /**
+   * @brief Function to get predecessor node.
+   *
+   * @details Finds the predecessor of a given node, which is the node with the
+   * largest value smaller than the given node's value.
+   * @param node The node for which the predecessor is to be found.
+   * @return A pointer to the predecessor node, or nil if no predecessor
+   * exists.
+   */
+  const Node *getPredecessor(const Node *node)
+    const {
+    if (node->left != nil) return getMaximum(node->left);
+    const Node *y = node->parent;
+    while (y != nil && node == y->left) {
+      node = y;
+      y = y->parent;
+    }
+    return y;
+  }
+
+  /** Finds the predecessor of a node of a tree that can be modified. */
+  Node *getPredecessor(const Node *node) {
+    return const_cast<Node *>(std::as_const(*this).getPredecessor(node));
+  }
+
+  /**
+   * @brief Returns an iterator to the smallest key.
+   *
+   * @return The iterator, equal to end() if the tree is empty.
+   */
+  Iterator begin() const {
+    return Iterator(this, root == nil ? nil : getMinimum(root));
+  }
+
+  /**
+   * @brief Returns the iterator past the largest key.
+   *
+   * @return The iterator.
+   */
+  Iterator end() const {
+    return Iterator(this, nil);
+  }
+
+  /**
+   * @brief Finds the first key that is not less than a value.
+   *
+   * @param value The value to compare with.
+   * @return Iterator to the key, or end() if every key is less than value.
+   */
+  Iterator lower_bound(const DataType &value) const {
+    return Iterator(this, lowerBound(value));
+  }
+
+  /**
+   * @brief Finds the first key that is greater than a value.
+   *
+   * @param value The value to compare with.
+   * @return Iterator to the key, or end() if no key is greater than value.
+   */
+  Iterator upper_bound(const DataType &value) const {
+    Node *node = root;
+    Node *bound = nil;
+    while (node != nil) {
+      if (value < node->key) {
+        bound = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return Iterator(this, bound);
+  }
+
+  /**
+   * @brief Visits, in ascending order, every key in the range [low, high].
+   *
+   * @details Descends once to the first key and then moves to each successor
+   * through parent pointers, without recursion or extra memory. It costs
+   * O(log n + k) for k visited keys.
+   * @param low The smallest key to visit.
+   * @param high The largest key to visit.
+   * @param visit Function called with each key.
+   */
+  template <typename Visitor>
+  void range(const DataType &low, const DataType &high, Visitor visit) const {
+    for (const Node *node = lowerBound(low);
+      node != nil && !(high < node->key); node = getSuccessor(node)) {
+      visit(node->key);
+    }
+  }
+
+  /**
+   * @brief Copies the keys into a read-only index for fast lookups.
+   *
+   * @details The index is a snapshot: later changes to the tree are not
+   * reflected in it. Its searches do not follow pointers and are several
+   * times faster than search(), so it suits trees that stop changing.
+   * @return The index, built in O(n).
+   */
+  EytzingerIndex<DataType> freeze() const {
+    return EytzingerIndex<DataType>(begin(), end());
+  }
+
+  /**
+   * @brief Saves the keys to a binary snapshot file (see Snapshot.hpp).
+   *
+   * @details The keys are written in ascending order, in the byte order of
+   * this machine. DataType must be trivially copyable.
+   * @param path Path of the file, which is replaced if it exists.
+   * @return True if the file was written completely.
+   */
+  bool saveSnapshot(const char *path) const {
+    SnapshotWriter<DataType> writer(path, kSnapshotRBTree);
+    for (const DataType &key : *this) {
+      writer.add(key);
+    }
+    return writer.finish();
+  }
+
+  /**
+   * @brief Replaces the keys of the tree with those of a snapshot file.
+   *
+   * @details The file is mapped into memory and the tree is built from its
+   * sorted keys with buildFromSorted(), in linear time and without searches
+   * or rotations.
+   * @param path Path of a file written by saveSnapshot().
+   * @return True if the file was loaded. If it cannot be read, or its header
+   * or key order is wrong, the tree is left unchanged and false is returned.
+   */
+  bool loadSnapshot(const char *path) {
+    SnapshotReader<DataType> reader(path, kSnapshotRBTree);
+    if (!reader.isValid()) return false;
+    for (const DataType *key = reader.begin(); key != reader.end(); ++key) {
+      if (key != reader.begin() && !(key[-1] < *key)) return false;
+    }
+    buildFromSorted(reader.begin(), reader.end());
+    return true;
+  }
+
+  /**
+   * @brief Retrieves the number of keys in the tree.
+   *
+   * @return The number of keys.
+   * @note Requires OrderStatistics.
+   */
+  size_t getSize() const {
+    static_assert(OrderStatistics, "getSize() requires OrderStatistics.");
+    return root->size;
+  }
+
+  /**
+   * @brief Finds the k-th smallest key of the tree, counting from 0.
+   *
+   * @details Descends once, choosing a side by the size of the left subtree,
+   * so it costs O(log n). The p-th percentile is select(p * (n - 1) / 100).
+   * @param k The position of the key in ascending order.
+   * @return A pointer to the node, or nil if k is not less than the number
+   * of keys.
+   * @note Requires OrderStatistics.
+   */
+  const Node *select(size_t k) const {
+    static_assert(OrderStatistics, "select() requires OrderStatistics.");
+    const Node *node = root;
+    while (node != nil) {
+      size_t leftSize = node->left->size;
+      if (k < leftSize) {
+        node = node->left;
+      } else if (k == leftSize) {
+        return node;
+      } else {
+        k -= leftSize + 1;
+        node = node->right;
+      }
+    }
+    return nil;
+  }
+
+  /** Finds the k-th smallest key of a tree that can be modified. */
+  Node *select(size_t k) {
+    return const_cast<Node *>(std::as_const(*this).select(k));
+  }
+
+  /**
+   * @brief Counts the keys that are less than a value, which is the position
+   * select() gives to the value if it is in the tree.
+   *
+   * @param value The value to rank.
+   * @return The number of keys less than value, in O(log n).
+   * @note Requires OrderStatistics.
+   */
+  size_t rank(const DataType &value) const {
+    static_assert(OrderStatistics, "rank() requires OrderStatistics.");
+    return countBelow(value, false);
+  }
+
+  /**
+   * @brief Counts the keys in the range [low, high] in O(log n).
+   *
+   * @param low The smallest key to count.
+   * @param high The largest key to count.
+   * @return The number of keys in the range.
+   * @note Requires OrderStatistics.
+   */
+  size_t countRange(const DataType &low, const DataType &high) const {
+    static_assert(OrderStatistics, "countRange() requires OrderStatistics.");
+    if (high < low) return 0;
+    return countBelow(high, true) - countBelow(low, false);
+  }
+
   /**
    * @brief Returns root node.
    *
    * @details Provides access to the root node of the red-black tree.
    * @return A pointer to the root node.
    */
-  RBTreeNode<DataType> *getRoot() const {
+  Node *getRoot() {
+    return root;
+  }
+
+  /** Returns the root node of a read-only tree. */
+  const Node *getRoot() const {
     return root;
   }
 
@@ -341,16 +862,80 @@ class RBTree {
    * leaves and boundaries.
    * @return A pointer to the sentinel node.
    */
-  RBTreeNode<DataType> *getNil() const {
+  Node *getNil() {
+    return nil;
+  }
+
+  /** Returns the sentinel node of a read-only tree. */
+  const Node *getNil() const {
     return nil;
   }
 
  private:
+  /** Number of lookups that searchBatch() keeps in flight. */
+  static constexpr size_t kBatchWidth = 16;
+
   /** Pointer to the tree's root node. */
-  RBTreeNode<DataType> *root;
+  Node *root;
 
   /** Sentinel node (NIL) used to represent empty nodes. */
-  RBTreeNode<DataType> *nil;
+  Node *nil;
+
+  /** Allocator of the nodes. */
+  Allocator<Node> allocator;
+
+  /**
+   * @brief Subtracts one from the subtree sizes of a node and its ancestors.
+   *
+   * @param node The lowest node whose subtree loses a node.
+   */
+  void decreaseSizes(Node *node) {
+    if constexpr (OrderStatistics) {
+      for (; node != nil; node = node->parent) --node->size;
+    }
+  }
+
+  /**
+   * @brief Counts the keys that are less than a value, or not greater than it.
+   *
+   * @param value The value to compare with.
+   * @param inclusive Whether keys equal to the value are also counted.
+   * @return The number of keys.
+   */
+  size_t countBelow(const DataType &value, bool inclusive) const {
+    size_t count = 0;
+    Node *node = root;
+    while (node != nil) {
+      bool below = inclusive ? !(value < node->key) : node->key < value;
+      if (below) {
+        count += node->left->size + 1;
+        node = node->right;
+      } else {
+        node = node->left;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * @brief Finds the node of the first key that is not less than a value.
+   *
+   * @param value The value to compare with.
+   * @return The node, or nil if every key is less than value.
+   */
+  Node *lowerBound(const DataType &value) const {
+    Node *node = root;
+    Node *bound = nil;
+    while (node != nil) {
+      if (node->key < value) {
+        node = node->right;
+      } else {
+        bound = node;
+        node = node->left;
+      }
+    }
+    return bound;
+  }
 
   /**
    * @brief Clears all nodes from the tree.
@@ -367,16 +952,57 @@ class RBTree {
    * @brief Recursive function to clear all nodes from the tree, releasing node
    * memory.
    *
+   * @details If the allocator frees its nodes in bulk and the keys need no
+   * destructor, the nodes are not visited.
    * @param node Node from which to start clearing.
    */
-  void clearTree(RBTreeNode<DataType> *node) {
+  void clearTree(Node *node) {
+    if constexpr (!Allocator<Node>::kBulkRelease ||
+      !std::is_trivially_destructible_v<DataType>) {
+      destroyTree(node);
+    }
+    allocator.release();
+  }
+
+  /**
+   * @brief Recursive function to destroy the nodes of a subtree.
+   *
+   * @param node Root of the subtree.
+   */
+  void destroyTree(Node *node) {
     if (node != nil) {
-      clearTree(node->left);
-      clearTree(node->right);
-      delete node;
+      destroyTree(node->left);
+      destroyTree(node->right);
+      allocator.destroy(node);
     }
   }
 
+  /**
+   * @brief Recursive function to build a balanced subtree from a sorted range.
+   *
+   * @param begin Iterator to the first value of the range.
+   * @param n Number of values in the range.
+   * @param parent Parent of the subtree.
+   * @param depth Depth of the root of the subtree.
+   * @param redDepth Depth of the nodes that are colored red.
+   * @return The root of the subtree, or nil if the range is empty.
+   */
+  template <typename Iterator>
+  Node *buildSubtree(Iterator begin,
+    typename std::iterator_traits<Iterator>::difference_type n,
+    Node *parent, size_t depth, size_t redDepth) {
+    if (n <= 0) return nil;
+    auto half = n / 2;
+    Iterator middle = std::next(begin, half);
+    Node *node = allocator.create(*middle, parent, nil, nil,
+      depth == redDepth ? RED : BLACK);
+    if constexpr (OrderStatistics) node->size = static_cast<size_t>(n);
+    node->left = buildSubtree(begin, half, node, depth + 1, redDepth);
+    node->right = buildSubtree(std::next(middle), n - half - 1, node,
+      depth + 1, redDepth);
+    return node;
+  }
+
   /**
    * @brief Auxiliary function to replace one subtree with another.
    *
@@ -384,17 +1010,16 @@ class RBTree {
    * @param u Node to be replaced.
    * @param v Node that will replace 'u'.
    */
-  void transplant(RBTreeNode<DataType> *u, RBTreeNode<DataType> *v) {
-    if (u->parent == nullptr) {
+  void transplant(Node *u, Node *v) {
+    if (u->parent == nil) {
       root = v;
     } else if (u == u->parent->left) {
       u->parent->left = v;
     } else {
       u->parent->right = v;
     }
-    if (v != nullptr) {
-      v->parent = u->parent;
-    }
+    /** Also set when 'v' is nil, because removeFixup climbs from it. */
+    v->parent = u->parent;
   }
 
   /**
@@ -403,10 +1028,10 @@ class RBTree {
    *
    * @param node Recently inserted node that may cause imbalance.
    */
-  void insertFixup(RBTreeNode<DataType> *node) {
+  void insertFixup(Node *node) {
     while (node->parent->color == RED) {
       if (node->parent == node->parent->parent->left) {
-        RBTreeNode<DataType> *uncle = node->parent->parent->right;
+        Node *uncle = node->parent->parent->right;
         if (uncle->color == RED) {
           node->parent->color = BLACK;
           uncle->color = BLACK;
@@ -422,7 +1047,7 @@ class RBTree {
           rotateRight(node->parent->parent);
         }
       } else {
-        RBTreeNode<DataType> *uncle = node->parent->parent->left;
+        Node *uncle = node->parent->parent->left;
         if (uncle->color == RED) {
           node->parent->color = BLACK;
           uncle->color = BLACK;
@@ -449,8 +1074,8 @@ class RBTree {
    * rebalance the tree.
    * @param x Node on which the rotation is performed.
    */
-  void rotateLeft(RBTreeNode<DataType> *x) {
-    RBTreeNode<DataType> *y = x->right;
+  void rotateLeft(Node *x) {
+    Node *y = x->right;
     x->right = y->left;
     if (y->left != nil) y->left->parent = x;
     y->parent = x->parent;
@@ -462,6 +1087,10 @@ class RBTree {
       x->parent->right = y;
     y->left = x;
     x->parent = y;
+    if constexpr (OrderStatistics) {
+      y->size = x->size;
+      x->size = x->left->size + x->right->size + 1;
+    }
   }
 
   /**
@@ -471,8 +1100,8 @@ class RBTree {
    * rebalance the tree.
    * @param y Node on which the rotation is performed.
    */
-  void rotateRight(RBTreeNode<DataType> *y) {
-    RBTreeNode<DataType> *x = y->left;
+  void rotateRight(Node *y) {
+    Node *x = y->left;
     y->left = x->right;
     if (x->right != nil) x->right->parent = y;
     x->parent = y->parent;
@@ -484,6 +1113,10 @@ class RBTree {
       y->parent->left = x;
     x->right = y;
     y->parent = x;
+    if constexpr (OrderStatistics) {
+      x->size = y->size;
+      y->size = y->left->size + y->right->size + 1;
+    }
   }
 
   /**
@@ -492,10 +1125,10 @@ class RBTree {
    *
    * @param x Node at which to start color correction.
    */
-  void removeFixup(RBTreeNode<DataType> *x) {
+  void removeFixup(Node *x) {
     while (x != root && x->color == BLACK) {
       if (x == x->parent->left) {
-        RBTreeNode<DataType> *w = x->parent->right;
+        Node *w = x->parent->right;
         if (w->color == RED) {
           w->color = BLACK;
           x->parent->color = RED;
@@ -519,7 +1152,7 @@ class RBTree {
           x = root;
         }
       } else {
-        RBTreeNode<DataType> *w = x->parent->left;
+        Node *w = x->parent->left;
         if (w->color == RED) {
           w->color = BLACK;
           x->parent->color = RED;
@@ -547,3 +1180,12 @@ class RBTree {
     x->color = BLACK;
   }
 };
+
+/**
+ * @brief Red-black tree of keys with mapped values, ordered by key (see
+ * KeyValuePair.hpp).
+ */
+template <typename Key, typename Value,
+  template <typename> class Allocator = NodePool,
+  bool OrderStatistics = false>
+using RBTreeMap = RBTree<KeyValuePair<Key, Value>, Allocator, OrderStatistics>;
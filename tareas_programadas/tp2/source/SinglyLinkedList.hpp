@@ -7,8 +7,13 @@
 
 #pragma once
 #include <iostream>
+#include <type_traits>
+#include <utility>
 
-template <typename DataType>
+#include "KeyValuePair.hpp"
+#include "NodePool.hpp"
+
+template <typename DataType, template <typename> class Allocator>
 class SLList;
 
 /**
@@ -19,7 +24,8 @@ class SLList;
 template <typename DataType>
 class SLListNode {
  public:
-  friend class SLList<DataType>;
+  template <typename, template <typename> class>
+  friend class SLList;
 
   /**
    * @brief Default constructor.
@@ -40,22 +46,50 @@ class SLListNode {
     this->next = next;
   }
 
+  /**
+   * @brief Constructor that builds the value in place.
+   * @param next Pointer to the next node in the list.
+   * @param args The arguments of the value's constructor.
+   */
+  template <typename... Args>
+  SLListNode(std::in_place_t, SLListNode<DataType> *next, Args &&...args)
+    : key(std::forward<Args>(args)...), next(next) {}
+
   /** Destructor. */
   ~SLListNode() {}
 
   /**
    * @brief Retrieves the value stored in the node.
-   * @return The value stored in the node.
+   * @return Reference to the value stored in the node.
    */
-  DataType getKey() const {
+  const DataType &getKey() const {
     return key;
   }
 
+  /**
+   * @brief Retrieves the mapped value, in a node of a map (see
+   * KeyValuePair.hpp).
+   * @return Reference to the value, which can be modified in place.
+   */
+  auto &getValue() {
+    return key.value;
+  }
+
+  /** Retrieves the mapped value of a read-only node. */
+  const auto &getValue() const {
+    return key.value;
+  }
+
   /**
    * @brief Retrieves the next node pointer.
    * @return Pointer to the next node in the list.
    */
-  SLListNode<DataType> *getNext() const {
+  SLListNode<DataType> *getNext() {
+    return next;
+  }
+
+  /** Retrieves the next node of a read-only node, also read-only. */
+  const SLListNode<DataType> *getNext() const {
     return next;
   }
 
@@ -64,7 +98,7 @@ class SLListNode {
    * @param key The new value to store.
    */
   void setKey(DataType key) {
-    this->key = key;
+    this->key = std::move(key);
   }
 
   /**
@@ -85,8 +119,10 @@ class SLListNode {
  * @brief Implements all functions to create a singly linked list with a
  * sentinel node.
  * @tparam DataType Type of data stored in the list nodes.
+ * @tparam Allocator Allocator of the nodes (see NodePool.hpp); by default
+ * nodes come from a pool owned by the list.
  */
-template <typename DataType>
+template <typename DataType, template <typename> class Allocator = NodePool>
 class SLList {
  public:
   /**
@@ -114,18 +150,67 @@ class SLList {
    * @param value The value to insert.
    */
   void insert(const DataType &value) {
-    SLListNode<DataType> *newNode =
-      new SLListNode<DataType>(value, nil->getNext());
+    emplace(value);
+  }
+
+  /**
+   * @brief Inserts a value at the beginning of the list, moving it into the
+   * node.
+   * @param value The value to insert.
+   */
+  void insert(DataType &&value) {
+    emplace(std::move(value));
+  }
+
+  /**
+   * @brief Inserts at the beginning of the list a value built in place.
+   * @param args The arguments of the value's constructor.
+   * @return Pointer to the new node.
+   */
+  template <typename... Args>
+  SLListNode<DataType> *emplace(Args &&...args) {
+    SLListNode<DataType> *newNode = allocator.create(std::in_place,
+      nil->getNext(), std::forward<Args>(args)...);
     nil->setNext(newNode);
+    return newNode;
+  }
+
+  /**
+   * @brief Inserts at the beginning of the list a value built in place from
+   * a key and the arguments of the mapped value, unless the key is already in
+   * the list.
+   * @param key The key, which is only copied or moved if it is inserted.
+   * @param args The arguments of the mapped value's constructor.
+   * @return The node with the key, and whether it was inserted.
+   */
+  template <typename Key, typename... Args>
+  std::pair<SLListNode<DataType> *, bool> try_emplace(Key &&key,
+    Args &&...args) {
+    SLListNode<DataType> *node = search(key);
+    if (node != nullptr) return {node, false};
+    return {emplace(std::forward<Key>(key), std::forward<Args>(args)...),
+      true};
   }
 
   /**
    * @brief Searches for the first occurrence of a value in the list.
-   * @param value The value to search for.
+   * @param value The value to search for; a bare key in a map.
+   * @return Pointer to the node containing the value, or nullptr if not found.
+   */
+  template <typename Key>
+  SLListNode<DataType> *search(const Key &value) {
+    return const_cast<SLListNode<DataType> *>(std::as_const(*this).search(
+      value));
+  }
+
+  /**
+   * @brief Searches a read-only list, whose values cannot be modified.
+   * @param value The value to search for; a bare key in a map.
    * @return Pointer to the node containing the value, or nullptr if not found.
    */
-  SLListNode<DataType> *search(const DataType &value) const {
-    SLListNode<DataType> *current = nil->getNext();
+  template <typename Key>
+  const SLListNode<DataType> *search(const Key &value) const {
+    const SLListNode<DataType> *current = nil->getNext();
     while (current != nil) {
       if (current->getKey() == value) {
         return current;
@@ -137,15 +222,16 @@ class SLList {
 
   /**
    * @brief Removes all nodes with a specified value from the list.
-   * @param value The value of the nodes to remove.
+   * @param value The value of the nodes to remove; a bare key in a map.
    */
-  void remove(const DataType &value) {
+  template <typename Key>
+  void remove(const Key &value) {
     SLListNode<DataType> *current = nil;
     while (current->getNext() != nil) {
       if (current->getNext()->getKey() == value) {
         SLListNode<DataType> *temp = current->getNext();
         current->setNext(temp->getNext());
-        delete temp;
+        allocator.destroy(temp);
       } else {
         current = current->getNext();
       }
@@ -156,7 +242,12 @@ class SLList {
    * @brief Retrieves the sentinel node.
    * @return Pointer to the sentinel node.
    */
-  SLListNode<DataType> *getNil() const {
+  SLListNode<DataType> *getNil() {
+    return nil;
+  }
+
+  /** Retrieves the sentinel node of a read-only list. */
+  const SLListNode<DataType> *getNil() const {
     return nil;
   }
 
@@ -164,14 +255,32 @@ class SLList {
   /** Sentinel node to ease list operations. */
   SLListNode<DataType> *nil;
 
-  /** Removes all nodes from the list. */
+  /** Allocator of the nodes. */
+  Allocator<SLListNode<DataType>> allocator;
+
+  /**
+   * @brief Removes all nodes from the list.
+   * @details If the allocator frees its nodes in bulk and the keys need no
+   * destructor, the nodes are not visited.
+   */
   void clear() {
-    SLListNode<DataType> *current = nil->getNext();
-    while (current != nil) {
-      SLListNode<DataType> *toDelete = current;
-      current = current->getNext();
-      delete toDelete;
+    if constexpr (!Allocator<SLListNode<DataType>>::kBulkRelease ||
+      !std::is_trivially_destructible_v<DataType>) {
+      SLListNode<DataType> *current = nil->getNext();
+      while (current != nil) {
+        SLListNode<DataType> *toDelete = current;
+        current = current->getNext();
+        allocator.destroy(toDelete);
+      }
     }
+    allocator.release();
     nil->setNext(nil);
   }
 };
+
+/**
+ * @brief Singly linked list of keys with mapped values (see KeyValuePair.hpp).
+ */
+template <typename Key, typename Value,
+  template <typename> class Allocator = NodePool>
+using SLListMap = SLList<KeyValuePair<Key, Value>, Allocator>;
@@ -0,0 +1,203 @@
+/*
+ * Credits
+ * Based on: Prof. Arturo Camacho, Universidad de Costa Rica
+ * Template provided by: Prof. Allan Berrocal Rojas
+ * Adapted by: Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+ */
+
+#pragma once
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Header at the start of a snapshot file. The keys follow it, stored
+ * as raw bytes in the byte order of the machine that wrote them.
+ */
+struct SnapshotHeader {
+  char magic[4];  /** Always "TP2S". */
+  uint32_t version;  /** Version of the layout, kSnapshotVersion. */
+  uint32_t kind;  /** Structure that wrote the file, a SnapshotKind. */
+  uint32_t keySize;  /** Size in bytes of each key. */
+  uint64_t count;  /** Number of keys after the header. */
+  uint64_t buckets;  /** Number of buckets of a hash table, 0 otherwise. */
+};
+
+/** Version of the snapshot layout; files of other versions are rejected. */
+constexpr uint32_t kSnapshotVersion = 1;
+
+/** Structures that write snapshots, so that one cannot load another's. */
+enum SnapshotKind : uint32_t {
+  kSnapshotRBTree = 1,  /** Keys of an RBTree, in ascending order. */
+  kSnapshotChainedHashTable = 2  /** Keys of a ChainedHashTable. */
+};
+
+/**
+ * @class SnapshotWriter
+ * @brief Writes a snapshot file key by key, through a buffer.
+ * @tparam DataType Type of the keys; it must be trivially copyable.
+ */
+template <typename DataType>
+class SnapshotWriter {
+  static_assert(std::is_trivially_copyable_v<DataType>,
+    "Snapshots store keys as raw bytes.");
+
+ public:
+  /**
+   * @brief Constructor that creates or truncates the file.
+   * @param path Path of the file.
+   * @param kind Structure that writes the file.
+   * @param buckets Number of buckets of a hash table, 0 otherwise.
+   */
+  SnapshotWriter(const char *path, SnapshotKind kind, uint64_t buckets = 0)
+    : file(std::fopen(path, "wb")) {
+    std::memcpy(header.magic, "TP2S", 4);
+    header.version = kSnapshotVersion;
+    header.kind = kind;
+    header.keySize = sizeof(DataType);
+    header.count = 0;
+    header.buckets = buckets;
+    ok = file != nullptr &&
+      std::fwrite(&header, sizeof(header), 1, file) == 1;
+    buffer.reserve(kBufferKeys);
+  }
+
+  /** Destructor. Closes the file if finish() was not called. */
+  ~SnapshotWriter() {
+    if (file != nullptr) std::fclose(file);
+  }
+
+  SnapshotWriter(const SnapshotWriter &) = delete;
+  SnapshotWriter &operator=(const SnapshotWriter &) = delete;
+
+  /**
+   * @brief Appends a key to the file.
+   * @param key The key to append.
+   */
+  void add(const DataType &key) {
+    buffer.push_back(key);
+    if (buffer.size() == kBufferKeys) flush();
+  }
+
+  /**
+   * @brief Writes the remaining keys and the final count, and closes the
+   * file.
+   * @return True if every write succeeded.
+   */
+  bool finish() {
+    flush();
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0 &&
+      std::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (file != nullptr) ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    return ok;
+  }
+
+ private:
+  /** Number of keys gathered before each write. */
+  static constexpr size_t kBufferKeys = 4096;
+
+  std::FILE *file;  /** The file being written. */
+  SnapshotHeader header;  /** Header, written again with the final count. */
+  std::vector<DataType> buffer;  /** Keys not written yet. */
+  bool ok;  /** Whether every write so far succeeded. */
+
+  /** Writes the buffered keys. */
+  void flush() {
+    if (ok && !buffer.empty()) {
+      ok = std::fwrite(buffer.data(), sizeof(DataType), buffer.size(), file)
+        == buffer.size();
+    }
+    header.count += buffer.size();
+    buffer.clear();
+  }
+};
+
+/**
+ * @class SnapshotReader
+ * @brief Maps a snapshot file into memory and checks its header, so that its
+ * keys can be read in place without copying the file.
+ * @tparam DataType Type of the keys; it must be trivially copyable.
+ */
+template <typename DataType>
+class SnapshotReader {
+  static_assert(std::is_trivially_copyable_v<DataType>,
+    "Snapshots store keys as raw bytes.");
+  static_assert(sizeof(SnapshotHeader) % alignof(DataType) == 0,
+    "The keys after the header must be aligned.");
+
+ public:
+  /**
+   * @brief Constructor that maps the file read-only.
+   * @param path Path of the file.
+   * @param kind Structure that must have written the file.
+   * @details isValid() tells whether the file could be mapped and its header
+   * matches the kind, the version, the key size and the file size.
+   */
+  SnapshotReader(const char *path, SnapshotKind kind) {
+    int descriptor = ::open(path, O_RDONLY);
+    if (descriptor < 0) return;
+    struct stat status;
+    if (::fstat(descriptor, &status) == 0 &&
+      static_cast<size_t>(status.st_size) >= sizeof(SnapshotHeader)) {
+      length = static_cast<size_t>(status.st_size);
+      void *memory = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE,
+        descriptor, 0);
+      if (memory != MAP_FAILED) {
+        data = static_cast<const char *>(memory);
+        /** The keys are read once, front to back. */
+        ::madvise(memory, length, MADV_SEQUENTIAL);
+      }
+    }
+    /** The mapping stays valid after the file is closed. */
+    ::close(descriptor);
+    if (data == nullptr) return;
+    const SnapshotHeader &header = getHeader();
+    valid = std::memcmp(header.magic, "TP2S", 4) == 0 &&
+      header.version == kSnapshotVersion && header.kind == kind &&
+      header.keySize == sizeof(DataType) &&
+      header.count == (length - sizeof(SnapshotHeader)) / sizeof(DataType) &&
+      (length - sizeof(SnapshotHeader)) % sizeof(DataType) == 0;
+  }
+
+  /** Destructor. Unmaps the file. */
+  ~SnapshotReader() {
+    if (data != nullptr) ::munmap(const_cast<char *>(data), length);
+  }
+
+  SnapshotReader(const SnapshotReader &) = delete;
+  SnapshotReader &operator=(const SnapshotReader &) = delete;
+
+  /** Whether the file was mapped and its header is correct. */
+  bool isValid() const {
+    return valid;
+  }
+
+  /** Header of the file. Requires isValid(). */
+  const SnapshotHeader &getHeader() const {
+    return *reinterpret_cast<const SnapshotHeader *>(data);
+  }
+
+  /** Pointer to the first key. Requires isValid(). */
+  const DataType *begin() const {
+    return reinterpret_cast<const DataType *>(data + sizeof(SnapshotHeader));
+  }
+
+  /** Pointer past the last key. Requires isValid(). */
+  const DataType *end() const {
+    return begin() + getHeader().count;
+  }
+
+ private:
+  const char *data = nullptr;  /** Start of the mapping. */
+  size_t length = 0;  /** Size of the file in bytes. */
+  bool valid = false;  /** Whether the header is correct. */
+};
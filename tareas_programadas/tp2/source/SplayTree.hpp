@@ -0,0 +1,385 @@
+/*
+ * Credits
+ * Based on: Prof. Arturo Camacho, Universidad de Costa Rica
+ * Template provided by: Prof. Allan Berrocal Rojas
+ * Adapted by: Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+ */
+
+#pragma once
+#include <cstddef>
+#include <stack>
+#include <type_traits>
+#include <utility>
+
+#include "KeyValuePair.hpp"
+#include "NodePool.hpp"
+
+template <typename DataType, template <typename> class Allocator>
+class SplayTree;
+
+/**
+ * @brief Node of a splay tree. It has no parent pointer, because splaying is
+ * done top-down.
+ *
+ * @tparam DataType Type of data stored in the node.
+ */
+template <typename DataType>
+class SplayTreeNode {
+ public:
+  template <typename, template <typename> class>
+  friend class SplayTree;
+
+  /**
+   * @brief Constructs a node without children whose key is built in place.
+   *
+   * @param args The arguments of the key's constructor.
+   */
+  template <typename... Args>
+  explicit SplayTreeNode(std::in_place_t, Args &&...args)
+    : key(std::forward<Args>(args)...) {}
+
+  /**
+   * @brief Retrieves the key stored in the node.
+   *
+   * @return Reference to the key value.
+   */
+  const DataType &getKey() const {
+    return key;
+  }
+
+  /**
+   * @brief Retrieves the mapped value, in a node of a map (see
+   * KeyValuePair.hpp).
+   *
+   * @return Reference to the value, which can be modified in place.
+   */
+  auto &getValue() {
+    return key.value;
+  }
+
+  /** Retrieves the mapped value of a read-only node. */
+  const auto &getValue() const {
+    return key.value;
+  }
+
+  /**
+   * @brief Retrieves the left child node.
+   *
+   * @return Pointer to the left child node.
+   */
+  SplayTreeNode *getLeft() {
+    return left;
+  }
+
+  /** Retrieves the left child of a read-only node, also read-only. */
+  const SplayTreeNode *getLeft() const {
+    return left;
+  }
+
+  /**
+   * @brief Retrieves the right child node.
+   *
+   * @return Pointer to the right child node.
+   */
+  SplayTreeNode *getRight() {
+    return right;
+  }
+
+  /** Retrieves the right child of a read-only node, also read-only. */
+  const SplayTreeNode *getRight() const {
+    return right;
+  }
+
+ private:
+  DataType key;  /** The key value stored in the node. */
+  SplayTreeNode *left = nullptr;  /** Pointer to the left child. */
+  SplayTreeNode *right = nullptr;  /** Pointer to the right child. */
+};
+
+/**
+ * @brief Self-adjusting binary search tree: every access moves the accessed
+ * key to the root.
+ *
+ * @details Each search, insertion and deletion splays the tree top-down
+ * around the key, rotating pairs of nodes on the way so that the path to the
+ * key is roughly halved in depth. Operations cost O(log n) amortized, and a
+ * key accessed often stays near the root, so under skewed traffic, such as a
+ * Zipf distribution, the hot keys are found in a few steps. The price is that
+ * searches modify the tree, so they are not const and the tree cannot be read
+ * by several threads at once. Duplicated values are ignored.
+ * @tparam DataType Type of data stored in the tree.
+ * @tparam Allocator Allocator of the nodes (see NodePool.hpp); by default
+ * nodes come from a pool owned by the tree.
+ */
+template <typename DataType, template <typename> class Allocator = NodePool>
+class SplayTree {
+ public:
+  using Node = SplayTreeNode<DataType>;
+
+  /** Constructor. */
+  SplayTree() = default;
+
+  /** Destructor. */
+  ~SplayTree() {
+    clear();
+  }
+
+  /** The nodes belong to the tree's allocator, so it cannot be copied. */
+  SplayTree(const SplayTree &) = delete;
+  SplayTree &operator=(const SplayTree &) = delete;
+
+  /**
+   * @brief Inserts a new value into the tree, which becomes the root.
+   *
+   * @param value The value to be inserted into the tree.
+   * @note Duplicated values are ignored.
+   */
+  void insert(const DataType &value) {
+    try_emplace(value);
+  }
+
+  /**
+   * @brief Inserts a new value into the tree, moving it into the node.
+   *
+   * @param value The value to be inserted into the tree.
+   * @note Duplicated values are ignored.
+   */
+  void insert(DataType &&value) {
+    try_emplace(std::move(value));
+  }
+
+  /**
+   * @brief Inserts a value built in place from its constructor's arguments.
+   *
+   * @details The value is built before splaying, to compare it, and then
+   * moved into the node.
+   * @param args The arguments of the value's constructor.
+   * @return The node with the value, and whether it was inserted.
+   */
+  template <typename... Args>
+  std::pair<Node *, bool> emplace(Args &&...args) {
+    return try_emplace(DataType(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Inserts a value built in place from a key and the arguments of
+   * the mapped value, unless the key is already in the tree. Either way, the
+   * node with the key ends up at the root.
+   *
+   * @param key The key, or a whole value; it is only copied or moved if it
+   * is inserted.
+   * @param args The arguments of the mapped value's constructor.
+   * @return The node with the key, and whether it was inserted.
+   */
+  template <typename Key, typename... Args>
+  std::pair<Node *, bool> try_emplace(Key &&key, Args &&...args) {
+    root = splay(root, key);
+    if (root != nullptr && root->key == key) return {root, false};
+    Node *node = allocator.create(std::in_place, std::forward<Key>(key),
+      std::forward<Args>(args)...);
+    if (root != nullptr) {
+      /** The root is the neighbor of the key; split the tree around it. */
+      if (node->key < root->key) {
+        node->left = root->left;
+        node->right = root;
+        root->left = nullptr;
+      } else {
+        node->right = root->right;
+        node->left = root;
+        root->right = nullptr;
+      }
+    }
+    root = node;
+    ++size;
+    return {node, true};
+  }
+
+  /**
+   * @brief Searches for a value and moves it, or the last node visited if
+   * it is missing, to the root.
+   *
+   * @param value The value to search for; a bare key in a map.
+   * @return Pointer to the node containing the value, or nullptr if not found.
+   */
+  template <typename Key>
+  Node *search(const Key &value) {
+    root = splay(root, value);
+    return root != nullptr && root->key == value ? root : nullptr;
+  }
+
+  /**
+   * @brief Deletes the node containing the specified value from the tree.
+   *
+   * @details The value is splayed to the root; then the largest key of its
+   * left subtree is splayed to the top of that subtree, where it has no
+   * right child, and takes the right subtree of the removed root.
+   * @param value The value of the node to be deleted; a bare key in a map.
+   */
+  template <typename Key>
+  void remove(const Key &value) {
+    root = splay(root, value);
+    if (root == nullptr || !(root->key == value)) return;
+    Node *node = root;
+    if (node->left == nullptr) {
+      root = node->right;
+    } else {
+      root = splay(node->left, value);
+      root->right = node->right;
+    }
+    allocator.destroy(node);
+    --size;
+  }
+
+  /**
+   * @brief Visits, in ascending order, every key in the range [low, high].
+   *
+   * @details Walks the tree in order with an explicit stack, skipping the
+   * subtrees outside the range, and does not splay, so it does not change
+   * the shape of the tree.
+   * @param low The smallest key to visit.
+   * @param high The largest key to visit.
+   * @param visit Function called with each key.
+   */
+  template <typename Visitor>
+  void range(const DataType &low, const DataType &high, Visitor visit) const {
+    std::stack<Node *> pending;
+    Node *node = root;
+    while (node != nullptr || !pending.empty()) {
+      while (node != nullptr) {
+        if (node->key < low) {
+          node = node->right;  /** The whole left subtree is below low. */
+        } else {
+          pending.push(node);
+          node = node->left;
+        }
+      }
+      if (pending.empty()) break;
+      node = pending.top();
+      pending.pop();
+      if (high < node->key) break;  /** Every key left is above high. */
+      visit(node->key);
+      node = node->right;
+    }
+  }
+
+  /**
+   * @brief Retrieves the number of keys in the tree.
+   *
+   * @return The number of keys.
+   */
+  size_t getSize() const {
+    return size;
+  }
+
+  /**
+   * @brief Retrieves the root of the tree, which holds the last key accessed.
+   *
+   * @return Pointer to the root node, or nullptr if the tree is empty.
+   */
+  Node *getRoot() {
+    return root;
+  }
+
+  /** Retrieves the root of a read-only tree. */
+  const Node *getRoot() const {
+    return root;
+  }
+
+ private:
+  Node *root = nullptr;  /** Root of the tree. */
+  size_t size = 0;  /** Number of keys in the tree. */
+  Allocator<Node> allocator;  /** Allocator of the nodes. */
+
+  /**
+   * @brief Top-down splay: moves the node with a key, or the last node on
+   * the search path if the key is missing, to the root of a subtree.
+   *
+   * @details Descends from the root, detaching the nodes that are smaller
+   * than the key into a left tree and the larger ones into a right tree.
+   * When two steps go the same way, the pair is rotated first (zig-zig),
+   * which is what shortens long paths. At the end, the left and right trees
+   * become the children of the found node.
+   * @param node The root of the subtree.
+   * @param key The key to splay.
+   * @return The new root of the subtree.
+   */
+  template <typename Key>
+  static Node *splay(Node *node, const Key &key) {
+    if (node == nullptr) return nullptr;
+    Node *left = nullptr;  /** Nodes smaller than the key. */
+    Node *right = nullptr;  /** Nodes larger than the key. */
+    Node **leftHook = &left;  /** Where the next smaller node goes. */
+    Node **rightHook = &right;  /** Where the next larger node goes. */
+    while (true) {
+      if (key < node->key) {
+        if (node->left == nullptr) break;
+        if (key < node->left->key) {
+          /** Zig-zig: rotate right. */
+          Node *child = node->left;
+          node->left = child->right;
+          child->right = node;
+          node = child;
+          if (node->left == nullptr) break;
+        }
+        /** Link the node into the right tree. */
+        *rightHook = node;
+        rightHook = &node->left;
+        node = node->left;
+      } else if (node->key < key) {
+        if (node->right == nullptr) break;
+        if (node->right->key < key) {
+          /** Zig-zig: rotate left. */
+          Node *child = node->right;
+          node->right = child->left;
+          child->left = node;
+          node = child;
+          if (node->right == nullptr) break;
+        }
+        /** Link the node into the left tree. */
+        *leftHook = node;
+        leftHook = &node->right;
+        node = node->right;
+      } else {
+        break;
+      }
+    }
+    *leftHook = node->left;
+    *rightHook = node->right;
+    node->left = left;
+    node->right = right;
+    return node;
+  }
+
+  /**
+   * @brief Removes all nodes from the tree.
+   *
+   * @details If the allocator frees its nodes in bulk and the keys need no
+   * destructor, the nodes are not visited. Otherwise they are visited with an
+   * explicit stack, because a splay tree can be as deep as its size.
+   */
+  void clear() {
+    if constexpr (!Allocator<Node>::kBulkRelease ||
+      !std::is_trivially_destructible_v<DataType>) {
+      std::stack<Node *> pending;
+      if (root != nullptr) pending.push(root);
+      while (!pending.empty()) {
+        Node *node = pending.top();
+        pending.pop();
+        if (node->left != nullptr) pending.push(node->left);
+        if (node->right != nullptr) pending.push(node->right);
+        allocator.destroy(node);
+      }
+    }
+    allocator.release();
+    root = nullptr;
+    size = 0;
+  }
+};
+
+/**
+ * @brief Splay tree of keys with mapped values, ordered by key (see
+ * KeyValuePair.hpp).
+ */
+template <typename Key, typename Value,
+  template <typename> class Allocator = NodePool>
+using SplayTreeMap = SplayTree<KeyValuePair<Key, Value>, Allocator>;
@@ -0,0 +1,189 @@
+/*
+ * Credits
+ * Based on: Prof. Arturo Camacho, Universidad de Costa Rica
+ * Template provided by: Prof. Allan Berrocal Rojas
+ * Adapted by: Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
+ */
+
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+#include "NodePool.hpp"
+
+/**
+ * @class UnrolledListNode
+ * @brief Represents a node of an unrolled linked list, holding up to
+ * Capacity keys in an array.
+ * @tparam DataType Type of the data stored in the node.
+ * @tparam Capacity Maximum number of keys in the node.
+ */
+template <typename DataType, size_t Capacity>
+struct alignas(64) UnrolledListNode {
+  DataType keys[Capacity]{};  /** Keys; only the first count are in use. */
+  size_t count = 0;  /** Number of keys in the node. */
+  UnrolledListNode *next = nullptr;  /** Pointer to the next node. */
+};
+
+/**
+ * @class UnrolledLinkedList
+ * @brief Implements a singly linked list that stores several keys per node,
+ * with the same insert, search and remove operations as SLList.
+ * @tparam DataType Type of data stored in the list.
+ * @tparam Capacity Keys per node; between 16 and 64 keeps a node within a few
+ * cache lines.
+ * @tparam Allocator Allocator of the nodes (see NodePool.hpp).
+ * @details A search follows one pointer per node instead of one per key, and
+ * compares all the keys of a node in a loop without early exits that the
+ * compiler can vectorize. New keys go into the first node until it is full.
+ * The order of the keys is not preserved: a removal fills its hole with the
+ * last key of the node, and a node that falls below half full is merged with
+ * the next one when they fit together.
+ */
+template <typename DataType, size_t Capacity = 32,
+  template <typename> class Allocator = NodePool>
+class UnrolledLinkedList {
+  static_assert(Capacity >= 2, "A node must hold at least 2 keys.");
+
+ public:
+  using Node = UnrolledListNode<DataType, Capacity>;
+
+  /** Constructor. */
+  UnrolledLinkedList() = default;
+
+  /** Destructor. */
+  ~UnrolledLinkedList() {
+    clear();
+  }
+
+  /** The nodes belong to the list's allocator, so it cannot be copied. */
+  UnrolledLinkedList(const UnrolledLinkedList &) = delete;
+  UnrolledLinkedList &operator=(const UnrolledLinkedList &) = delete;
+
+  /**
+   * @brief Inserts a value in the first node, or in a new first node if it is
+   * full.
+   * @param value The value to insert.
+   */
+  void insert(const DataType &value) {
+    if (head == nullptr || head->count == Capacity) {
+      Node *node = allocator.create();
+      node->next = head;
+      head = node;
+    }
+    head->keys[head->count++] = value;
+    ++size;
+  }
+
+  /**
+   * @brief Searches for the first occurrence of a value in the list.
+   * @param value The value to search for.
+   * @return Pointer to the stored value, or nullptr if not found.
+   */
+  DataType *search(const DataType &value) const {
+    for (Node *node = head; node != nullptr; node = node->next) {
+      size_t index = find(node, value);
+      if (index != Capacity) return &node->keys[index];
+    }
+    return nullptr;  /** Value not found. */
+  }
+
+  /**
+   * @brief Removes all occurrences of a value from the list.
+   * @param value The value to remove.
+   */
+  void remove(const DataType &value) {
+    Node *previous = nullptr;
+    Node *node = head;
+    while (node != nullptr) {
+      size_t index;
+      while ((index = find(node, value)) != Capacity) {
+        /** Fill the hole with the last key of the node. */
+        node->keys[index] = node->keys[--node->count];
+        --size;
+      }
+      Node *next = node->next;
+      if (node->count == 0) {
+        /** Unlink the empty node. */
+        if (previous == nullptr) {
+          head = next;
+        } else {
+          previous->next = next;
+        }
+        allocator.destroy(node);
+      } else {
+        if (node->count < Capacity / 2 && next != nullptr &&
+          node->count + next->count <= Capacity) {
+          /** Merge the next node into this one; it is scanned here. */
+          for (size_t i = 0; i < next->count; ++i) {
+            node->keys[node->count++] = next->keys[i];
+          }
+          node->next = next->next;
+          allocator.destroy(next);
+          continue;
+        }
+        previous = node;
+      }
+      node = next;
+    }
+  }
+
+  /**
+   * @brief Retrieves the number of keys in the list.
+   * @return The number of keys.
+   */
+  size_t getSize() const {
+    return size;
+  }
+
+  /**
+   * @brief Retrieves the first node.
+   * @return Pointer to the first node, or nullptr if the list is empty.
+   */
+  Node *getHead() const {
+    return head;
+  }
+
+ private:
+  Node *head = nullptr;  /** First node of the list. */
+  size_t size = 0;  /** Number of keys in the list. */
+  Allocator<Node> allocator;  /** Allocator of the nodes. */
+
+  /**
+   * @brief Finds a value inside a node.
+   * @return The index of the first match, or Capacity if there is none.
+   * @details The first loop compares all Capacity slots, masking the unused
+   * ones, without exiting early, so its trip count is a constant and it
+   * compiles to vector comparisons; the position is only looked up when
+   * there is a match.
+   */
+  static size_t find(const Node *node, const DataType &value) {
+    /** Same width as int keys, so the mask fits in the vector lanes. */
+    const unsigned count = static_cast<unsigned>(node->count);
+    unsigned found = 0;
+    for (unsigned i = 0; i < Capacity; ++i) {
+      found |= static_cast<unsigned>(node->keys[i] == value) &
+        static_cast<unsigned>(i < count);
+    }
+    if (found == 0) return Capacity;
+    size_t index = 0;
+    while (!(node->keys[index] == value)) ++index;
+    return index;
+  }
+
+  /** Removes all nodes from the list. */
+  void clear() {
+    if constexpr (!Allocator<Node>::kBulkRelease ||
+      !std::is_trivially_destructible_v<DataType>) {
+      Node *node = head;
+      while (node != nullptr) {
+        Node *next = node->next;
+        allocator.destroy(node);
+        node = next;
+      }
+    }
+    allocator.release();
+    head = nullptr;
+    size = 0;
+  }
+};
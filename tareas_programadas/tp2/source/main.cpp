@@ -1,13 +1,51 @@
 // Copyright 2024 Josué Torres Sibaja <josue.torressibaja@ucr.ac.cr>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <mutex>
 #include <random>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "SinglyLinkedList.hpp"
 #include "BinarySearchTree.hpp"
 #include "RedBlackTree.hpp"
+#include "SplayTree.hpp"
 #include "ChainedHashTable.hpp"
+#include "DoublyLinkedList.hpp"
+#include "ConcurrentHashTable.hpp"
+#include "ConcurrentSkipList.hpp"
+#include "FlatHashTable.hpp"
+#include "Hashers.hpp"
+#include "NodePool.hpp"
+#include "UnrolledLinkedList.hpp"
+#include "BPlusTree.hpp"
+
+/** Returns the name used to report the times of a structure. */
+template <typename Structure>
+std::string structureName() {
+  if constexpr (std::is_same_v<Structure, BSTree<int>>) {
+    return "Binary Search Tree";
+  } else if constexpr (std::is_same_v<Structure, RBTree<int>>) {
+    return "Red-Black Tree";
+  } else if constexpr (std::is_same_v<Structure, SplayTree<int>>) {
+    return "Splay Tree";
+  } else if constexpr (std::is_same_v<Structure, BPlusTree<int>>) {
+    return "B+ Tree";
+  } else if constexpr (std::is_same_v<Structure, ChainedHashTable<int>>) {
+    return "Hash Table";
+  } else if constexpr (std::is_same_v<Structure, FlatHashTable<int>>) {
+    return "Flat Hash Table";
+  } else if constexpr (std::is_same_v<Structure, UnrolledLinkedList<int>>) {
+    return "Unrolled Linked List";
+  } else {
+    return "Singly Linked List";
+  }
+}
 
 /** Function to handle insertion in any structure. */
 template <typename Structure>
@@ -16,25 +54,18 @@ void measureInsertion(Structure& structure, int n, std::mt19937& rng,
   auto start = std::chrono::high_resolution_clock::now();
   if (ordered) {
     /** Ordered insertion. */
-    if constexpr (std::is_same_v<Structure, BSTree<int>>) {
-      structure.fastInsert(n);
-      std::cout << "Insertion time (ordered) in Binary Search Tree "
-        "(fastInsert): ";
-    } else if constexpr (std::is_same_v<Structure, RBTree<int>>) {
-      for (int i = 0; i < n; ++i) {
-        structure.insert(i);
-      }
-      std::cout << "Insertion time (ordered) in Red-Black Tree: ";
-    } else if constexpr (std::is_same_v<Structure, ChainedHashTable<int>>) {
+    if constexpr (std::is_same_v<Structure, BSTree<int>> ||
+      std::is_same_v<Structure, RBTree<int>>) {
+      /** The trees build a balanced tree from the sorted keys at once. */
+      std::vector<int> keys(n);
       for (int i = 0; i < n; ++i) {
-        structure.insert(i);
+        keys[i] = i;
       }
-      std::cout << "Insertion time (ordered) in Hash Table: ";
+      structure.buildFromSorted(keys.begin(), keys.end());
     } else {
       for (int i = 0; i < n; ++i) {
         structure.insert(i);
       }
-      std::cout << "Insertion time (ordered) in Singly Linked List: ";
     }
   } else {
     /** Random insertion. */
@@ -42,19 +73,16 @@ void measureInsertion(Structure& structure, int n, std::mt19937& rng,
       int value = dist(rng);
       structure.insert(value);
     }
-    if constexpr (std::is_same_v<Structure, BSTree<int>>) {
-      std::cout << "Insertion time (random) in Binary Search Tree: ";
-    } else if constexpr (std::is_same_v<Structure, RBTree<int>>) {
-      std::cout << "Insertion time (random) in Red-Black Tree: ";
-    } else if constexpr (std::is_same_v<Structure, ChainedHashTable<int>>) {
-      std::cout << "Insertion time (random) in Hash Table: ";
-    } else {
-      std::cout << "Insertion time (random) in Singly Linked List: ";
-    }
   }
   auto end = std::chrono::high_resolution_clock::now();
+  std::cout << "Insertion time " << (ordered ? "(ordered)" : "(random)")
+    << " in " << structureName<Structure>();
+  if constexpr (std::is_same_v<Structure, BSTree<int>> ||
+    std::is_same_v<Structure, RBTree<int>>) {
+    if (ordered) std::cout << " (buildFromSorted)";
+  }
   std::chrono::duration<double, std::milli> elapsed = end - start;
-  std::cout << elapsed.count() << " ms\n";
+  std::cout << ": " << elapsed.count() << " ms\n";
 }
 
 /** Function to handle search in any structure. */
@@ -67,30 +95,143 @@ void measureSearch(Structure& structure, int e, std::mt19937& rng,
     if constexpr (std::is_same_v<Structure, BSTree<int>> ||
       std::is_same_v<Structure, RBTree<int>>) {
       structure.search(structure.getRoot(), value);
-    } else if constexpr (std::is_same_v<Structure, ChainedHashTable<int>>) {
-      structure.search(value);
     } else {
       structure.search(value);
     }
   }
   auto end = std::chrono::high_resolution_clock::now();
-  if constexpr (std::is_same_v<Structure, BSTree<int>>) {
-    std::cout << "Search time " << (ordered ? "(ordered)" : "(random)")
-      << " in Binary Search Tree: ";
-  } else if constexpr (std::is_same_v<Structure, RBTree<int>>) {
-    std::cout << "Search time " << (ordered ? "(ordered)" : "(random)")
-      << " in Red-Black Tree: ";
-  } else if constexpr (std::is_same_v<Structure, ChainedHashTable<int>>) {
-    std::cout << "Search time " << (ordered ? "(ordered)" : "(random)")
-      << " in Hash Table: ";
-  } else {
-    std::cout << "Search time " << (ordered ? "(ordered)" : "(random)")
-      << " in Singly Linked List: ";
-  }
+  std::cout << "Search time " << (ordered ? "(ordered)" : "(random)")
+    << " in " << structureName<Structure>() << ": ";
   std::chrono::duration<double, std::milli> elapsed = end - start;
   std::cout << elapsed.count() << " ms\n";
 }
 
+/**
+ * Function to compare e searches done one by one with the same searches done
+ * with searchBatch(), which overlaps their cache misses.
+ */
+template <typename Structure>
+void measureSearchBatch(Structure& structure, int e, std::mt19937& rng,
+  std::uniform_int_distribution<int>& dist) {
+  std::vector<int> keys(e);
+  for (int& key : keys) {
+    key = dist(rng);
+  }
+  /** searchBatch() is const, so the searches one by one are too. */
+  const Structure& reader = structure;
+  auto lookup = [&reader](int key) {
+    if constexpr (std::is_same_v<Structure, BSTree<int>> ||
+      std::is_same_v<Structure, RBTree<int>>) {
+      return reader.search(reader.getRoot(), key);
+    } else {
+      return reader.search(key);
+    }
+  };
+  std::vector<decltype(lookup(0))> results(e);
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < e; ++i) {
+    results[i] = lookup(keys[i]);
+  }
+  auto middle = std::chrono::high_resolution_clock::now();
+  structure.searchBatch(keys.data(), e, results.data());
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> single = middle - start;
+  std::chrono::duration<double, std::milli> batched = end - middle;
+  std::cout << "Search time (random) in " << structureName<Structure>()
+    << ", one by one / searchBatch(): " << single.count() << " ms / "
+    << batched.count() << " ms\n";
+}
+
+/**
+ * Function to compare e random searches and lower bounds in a red-black tree
+ * with the same queries in the read-only index returned by freeze().
+ */
+template <typename Structure>
+void measureFrozenSearch(Structure& structure, int e, std::mt19937& rng,
+  std::uniform_int_distribution<int>& dist) {
+  std::vector<int> keys(e);
+  for (int& key : keys) {
+    key = dist(rng);
+  }
+  auto start = std::chrono::high_resolution_clock::now();
+  auto index = structure.freeze();
+  auto built = std::chrono::high_resolution_clock::now();
+  long long found = 0;
+  for (int key : keys) {
+    found += structure.search(structure.getRoot(), key) !=
+      structure.getNil();
+  }
+  for (int key : keys) {
+    found += structure.lower_bound(key) != structure.end();
+  }
+  auto middle = std::chrono::high_resolution_clock::now();
+  for (int key : keys) {
+    found -= index.contains(key);
+  }
+  for (int key : keys) {
+    found -= index.lower_bound(key) != nullptr;
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> build = built - start;
+  std::chrono::duration<double, std::milli> tree = middle - built;
+  std::chrono::duration<double, std::milli> frozen = end - middle;
+  std::cout << "Search and lower bound time (random) in "
+    << structureName<Structure>() << " / freeze(): " << tree.count()
+    << " ms / " << frozen.count() << " ms (built in " << build.count()
+    << " ms, mismatches " << found << ")\n";
+}
+
+/**
+ * Function to compare ways of adding up every key of a hash table: copying
+ * its buckets and walking the copy, as getTable() used to require, with
+ * iterators, with forEach() and with forEachParallel() on every core.
+ */
+void measureTableScan(ChainedHashTable<int>& table) {
+  using Bucket = ChainedHashTable<int>::Bucket;
+  long long sums[4] = {0, 0, 0, 0};
+  auto start = std::chrono::high_resolution_clock::now();
+  const ChainedHashTable<int>::BucketArray& buckets = table.getTable();
+  std::vector<Bucket> copy(buckets.begin(), buckets.end());
+  for (const Bucket& bucket : copy) {
+    const DLListNode<int>* nil = bucket.getNil();
+    if (nil == nullptr) continue;
+    for (const DLListNode<int>* node = nil->getNext(); node != nil;
+      node = node->getNext()) {
+      sums[0] += node->getKey();
+    }
+  }
+  auto copied = std::chrono::high_resolution_clock::now();
+  for (int key : table) {
+    sums[1] += key;
+  }
+  auto iterated = std::chrono::high_resolution_clock::now();
+  table.forEach([&sums](int key) { sums[2] += key; });
+  auto visited = std::chrono::high_resolution_clock::now();
+  size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  /** One partial sum per thread, each in its own cache line. */
+  struct alignas(64) Partial {
+    long long sum = 0;
+  };
+  std::vector<Partial> partials(threads);
+  table.forEachParallel(threads, [&partials](size_t worker, int key) {
+    partials[worker].sum += key;
+  });
+  for (const Partial& partial : partials) {
+    sums[3] += partial.sum;
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> copying = copied - start;
+  std::chrono::duration<double, std::milli> iterating = iterated - copied;
+  std::chrono::duration<double, std::milli> visiting = visited - iterated;
+  std::chrono::duration<double, std::milli> parallel = end - visited;
+  std::cout << "Full scan of Hash Table, copy / iterators / forEach() / "
+    << "forEachParallel() with " << threads << " threads: "
+    << copying.count() << " ms / " << iterating.count() << " ms / "
+    << visiting.count() << " ms / " << parallel.count() << " ms"
+    << (sums[0] == sums[1] && sums[1] == sums[2] && sums[2] == sums[3] ?
+      "" : " (sums differ)") << "\n";
+}
+
 /** Function to handle deletion in any structure. */
 template <typename Structure>
 void measureDeletion(Structure& structure, int e, std::mt19937& rng,
@@ -101,24 +242,533 @@ void measureDeletion(Structure& structure, int e, std::mt19937& rng,
     structure.remove(value);
   }
   auto end = std::chrono::high_resolution_clock::now();
-  if constexpr (std::is_same_v<Structure, BSTree<int>>) {
-    std::cout << "Deletion time " << (ordered ? "(ordered)" : "(random)")
-      << " in Binary Search Tree: ";
-  } else if constexpr (std::is_same_v<Structure, RBTree<int>>) {
-    std::cout << "Deletion time " << (ordered ? "(ordered)" : "(random)")
-      << " in Red-Black Tree: ";
-  } else if constexpr (std::is_same_v<Structure, ChainedHashTable<int>>) {
-    std::cout << "Deletion time " << (ordered ? "(ordered)" : "(random)")
-      << " in Hash Table: ";
-  } else {
-    std::cout << "Deletion time " << (ordered ? "(ordered)" : "(random)")
-      << " in Singly Linked List: ";
-  }
+  std::cout << "Deletion time " << (ordered ? "(ordered)" : "(random)")
+    << " in " << structureName<Structure>() << ": ";
   std::chrono::duration<double, std::milli> elapsed = end - start;
   std::cout << elapsed.count() << " ms\n";
   std::cout << "\n";
 }
 
+/**
+ * Function to measure an ordered range query of e keys in a tree, done with
+ * one range() scan and with one search() per key.
+ */
+template <typename Structure>
+void measureRangeScan(Structure& structure, int e, int low) {
+  long long sum = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  structure.range(low, low + e - 1, [&sum](int key) { sum += key; });
+  auto middle = std::chrono::high_resolution_clock::now();
+  /** The end iterator holds what search() returns for a missing key. */
+  auto missing = structure.end().getNode();
+  for (int key = low; key < low + e; ++key) {
+    if (structure.search(structure.getRoot(), key) != missing) sum += key;
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> scan = middle - start;
+  std::chrono::duration<double, std::milli> searches = end - middle;
+  std::cout << "Range query of " << e << " keys in "
+    << structureName<Structure>() << ": range() " << scan.count()
+    << " ms, search() per key " << searches.count() << " ms (checksum "
+    << sum << ")\n\n";
+}
+
+/**
+ * Function to measure the cost of keeping subtree sizes in a red-black tree
+ * and the rank and select queries they allow, against walking the tree in
+ * order to find the k-th key.
+ */
+void measureOrderStatistics(int n, int e, std::mt19937& rng) {
+  std::uniform_int_distribution<int> dist(0, 3 * n - 1);
+  std::vector<int> keys(n);
+  for (int& key : keys) {
+    key = dist(rng);
+  }
+  RBTree<int> plain;
+  RBTree<int, NodePool, true> augmented;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int key : keys) {
+    plain.insert(key);
+  }
+  auto middle = std::chrono::high_resolution_clock::now();
+  for (int key : keys) {
+    augmented.insert(key);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> plainTime = middle - start;
+  std::chrono::duration<double, std::milli> augmentedTime = end - middle;
+  std::cout << "Insertion time (random) in Red-Black Tree without / with "
+    << "subtree sizes: " << plainTime.count() << " ms / "
+    << augmentedTime.count() << " ms\n";
+
+  size_t size = augmented.getSize();
+  std::uniform_int_distribution<size_t> position(0, size - 1);
+  long long sum = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < e; ++i) {
+    sum += augmented.select(position(rng))->getKey();
+    sum += augmented.rank(dist(rng));
+  }
+  end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> queries = end - start;
+
+  /** Walking in order costs O(n) per query, so only a few are measured. */
+  constexpr int walks = 10;
+  start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < walks; ++i) {
+    auto it = plain.begin();
+    std::advance(it, position(rng));
+    sum += *it;
+  }
+  end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> walking = end - start;
+  std::cout << "Order statistics in Red-Black Tree: select() + rank() "
+    << queries.count() * 1000 / e << " us per query, in-order walk "
+    << walking.count() * 1000 / walks << " us per query (checksum " << sum
+    << ")\n\n";
+}
+
+/**
+ * Function to measure the latency of each insertion in a structure that
+ * starts small and has to grow, reporting the slowest insertions.
+ */
+template <typename Structure>
+void measureInsertionLatency(Structure& structure, int n, std::mt19937& rng,
+  std::uniform_int_distribution<int>& dist) {
+  std::vector<double> latencies(n);
+  for (int i = 0; i < n; ++i) {
+    int value = dist(rng);
+    auto start = std::chrono::high_resolution_clock::now();
+    structure.insert(value);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::micro> elapsed = end - start;
+    latencies[i] = elapsed.count();
+  }
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << "Insertion latency (growing) in " << structureName<Structure>()
+    << ": p99 " << latencies[n / 100 * 99] << " us, p99.9 "
+    << latencies[n / 1000 * 999] << " us, max " << latencies[n - 1]
+    << " us\n\n";
+}
+
+/**
+ * Function to measure the lookups and the chain lengths of a hash table with
+ * a given hasher policy.
+ */
+template <typename Key, typename Hasher>
+void measureHasher(const std::string& name, const std::vector<Key>& keys,
+  const std::vector<Key>& queries) {
+  ChainedHashTable<Key, Hasher> table(16);
+  for (const Key& key : keys) {
+    table.insert(key);
+  }
+  size_t found = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (const Key& query : queries) {
+    found += (table.search(query) != nullptr);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> elapsed = end - start;
+  std::vector<size_t> histogram = table.getChainLengthHistogram();
+  std::cout << name << ": search " << elapsed.count() << " ms (" << found
+    << " found) | buckets with 0/1/2/3/4+ keys:";
+  size_t longer = 0;
+  for (size_t length = 0; length < histogram.size(); ++length) {
+    if (length < 4) {
+      std::cout << " " << histogram[length];
+    } else {
+      longer += histogram[length];
+    }
+  }
+  for (size_t length = histogram.size(); length < 4; ++length) {
+    std::cout << " 0";
+  }
+  std::cout << " " << longer << " | longest chain: " << histogram.size() - 1
+    << "\n";
+}
+
+/**
+ * Function to compare the hasher policies on random keys, on keys that are
+ * multiples of a power of two (which share a stride with the table sizes)
+ * and, for the string hasher, on random strings.
+ */
+void compareHashers(int n, int e, std::mt19937& rng) {
+  std::cout << "----- Hasher policies -----\n\n";
+  std::uniform_int_distribution<uint64_t> dist(0, 3 * uint64_t(n) - 1);
+  std::vector<uint64_t> keys(n);
+  std::vector<uint64_t> queries(e);
+  for (uint64_t& key : keys) key = dist(rng);
+  for (uint64_t& query : queries) query = dist(rng);
+  std::cout << "Random keys:\n";
+  measureHasher<uint64_t, ModuloHash>("Modulo", keys, queries);
+  measureHasher<uint64_t, FibonacciHash>("Fibonacci", keys, queries);
+  measureHasher<uint64_t, FastRangeHash>("Fastrange", keys, queries);
+  measureHasher<uint64_t, WyHash>("WyHash", keys, queries);
+
+  /** Fewer keys, because modulo puts them all in the same chain. */
+  int strided = n / 50;
+  std::vector<uint64_t> stridedKeys(strided);
+  std::vector<uint64_t> stridedQueries(e);
+  for (int i = 0; i < strided; ++i) stridedKeys[i] = uint64_t(i) << 20;
+  for (uint64_t& query : stridedQueries) query = (dist(rng) % strided) << 20;
+  std::cout << "\nKeys that are multiples of 2^20:\n";
+  measureHasher<uint64_t, ModuloHash>("Modulo", stridedKeys, stridedQueries);
+  measureHasher<uint64_t, FibonacciHash>("Fibonacci", stridedKeys,
+    stridedQueries);
+  measureHasher<uint64_t, FastRangeHash>("Fastrange", stridedKeys,
+    stridedQueries);
+  measureHasher<uint64_t, WyHash>("WyHash", stridedKeys, stridedQueries);
+
+  std::vector<std::string> words(n);
+  std::vector<std::string> wordQueries(e);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  for (std::string& word : words) {
+    word.resize(8 + rng() % 16);
+    for (char& c : word) c = static_cast<char>(letter(rng));
+  }
+  for (int i = 0; i < e; ++i) wordQueries[i] = words[rng() % n];
+  std::cout << "\nRandom strings:\n";
+  measureHasher<std::string, WyHash>("WyHash", words, wordQueries);
+  std::cout << "\n";
+}
+
+/**
+ * Function to run a mixed workload (80% searches, 10% insertions and 10%
+ * deletions) on a table from several threads at once.
+ * @return The throughput in millions of operations per second.
+ */
+template <typename Operation>
+double measureThroughput(int threads, int operations, int range,
+  Operation operation) {
+  std::vector<std::thread> workers;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([=]() {
+      std::mt19937 rng(t + 1);
+      std::uniform_int_distribution<int> dist(0, range - 1);
+      for (int i = 0; i < operations / threads; ++i) {
+        int kind = rng() % 10;
+        operation(kind == 0 ? 'i' : (kind == 1 ? 'r' : 's'), dist(rng));
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> elapsed = end - start;
+  return operations / elapsed.count() / 1e6;
+}
+
+/**
+ * Function to compare a Hash Table behind one global mutex with the
+ * Concurrent Hash Table, from 1 thread up to all the available cores.
+ */
+void measureConcurrency(int operations, int range) {
+  std::cout << "----- Concurrent Hash Table -----\n\n";
+  int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+  if (maxThreads <= 0) maxThreads = 1;
+  std::vector<int> threadCounts;
+  for (int threads = 1; threads < maxThreads; threads *= 2) {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(maxThreads);
+  for (int threads : threadCounts) {
+    ChainedHashTable<int> locked(range);
+    std::mutex mutex;
+    ConcurrentHashTable<int> concurrent(range);
+    for (int key = 0; key < range; key += 2) {
+      locked.insert(key);
+      concurrent.insert(key);
+    }
+    double lockedRate = measureThroughput(threads, operations, range,
+      [&](char kind, int key) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (kind == 'i') {
+          locked.insert(key);
+        } else if (kind == 'r') {
+          locked.remove(key);
+        } else {
+          locked.search(key);
+        }
+      });
+    double concurrentRate = measureThroughput(threads, operations, range,
+      [&](char kind, int key) {
+        if (kind == 'i') {
+          concurrent.insert(key);
+        } else if (kind == 'r') {
+          concurrent.remove(key);
+        } else {
+          concurrent.search(key);
+        }
+      });
+    std::cout << threads << " thread(s): Hash Table with a global mutex "
+      << lockedRate << " Mops/s | Concurrent Hash Table " << concurrentRate
+      << " Mops/s\n";
+  }
+  std::cout << "\n";
+}
+
+/**
+ * Function to compare a Red-Black Tree behind one global mutex with the
+ * Concurrent Skip List, from 1 thread up to all the available cores.
+ */
+void measureOrderedConcurrency(int operations, int range) {
+  std::cout << "----- Concurrent Skip List -----\n\n";
+  int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+  if (maxThreads <= 0) maxThreads = 1;
+  std::vector<int> threadCounts;
+  for (int threads = 1; threads < maxThreads; threads *= 2) {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(maxThreads);
+  for (int threads : threadCounts) {
+    RBTree<int> locked;
+    std::mutex mutex;
+    ConcurrentSkipList<int> concurrent;
+    for (int key = 0; key < range; key += 2) {
+      locked.insert(key);
+      concurrent.insert(key);
+    }
+    double lockedRate = measureThroughput(threads, operations, range,
+      [&](char kind, int key) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (kind == 'i') {
+          locked.insert(key);
+        } else if (kind == 'r') {
+          locked.remove(key);
+        } else {
+          locked.search(locked.getRoot(), key);
+        }
+      });
+    double concurrentRate = measureThroughput(threads, operations, range,
+      [&](char kind, int key) {
+        if (kind == 'i') {
+          concurrent.insert(key);
+        } else if (kind == 'r') {
+          concurrent.remove(key);
+        } else {
+          concurrent.search(key);
+        }
+      });
+    std::cout << threads << " thread(s): Red-Black Tree with a global mutex "
+      << lockedRate << " Mops/s | Concurrent Skip List " << concurrentRate
+      << " Mops/s\n";
+  }
+  std::cout << "\n";
+}
+
+/**
+ * Function to time inserting random keys into a structure with a given node
+ * allocator, and then destroying the structure.
+ */
+template <typename Structure>
+void measureAllocator(const std::string& name, const std::vector<int>& keys) {
+  Structure* structure = new Structure();
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int key : keys) {
+    structure->insert(key);
+  }
+  auto middle = std::chrono::high_resolution_clock::now();
+  delete structure;
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> insertion = middle - start;
+  std::chrono::duration<double, std::milli> destruction = end - middle;
+  std::cout << name << ": insertion " << insertion.count()
+    << " ms, destruction " << destruction.count() << " ms\n";
+}
+
+/**
+ * Function to compare the node pool with the global new and delete in the
+ * lists and trees.
+ */
+void compareAllocators(int n, std::mt19937& rng) {
+  std::cout << "----- Node allocators -----\n\n";
+  std::uniform_int_distribution<int> dist(0, 3 * n - 1);
+  std::vector<int> keys(n);
+  for (int& key : keys) key = dist(rng);
+  measureAllocator<SLList<int, NewDeleteAllocator>>(
+    "Singly Linked List (new/delete)", keys);
+  measureAllocator<SLList<int, NodePool>>(
+    "Singly Linked List (node pool)", keys);
+  measureAllocator<DLList<int, NewDeleteAllocator>>(
+    "Doubly Linked List (new/delete)", keys);
+  measureAllocator<DLList<int, NodePool>>(
+    "Doubly Linked List (node pool)", keys);
+  measureAllocator<BSTree<int, NewDeleteAllocator>>(
+    "Binary Search Tree (new/delete)", keys);
+  measureAllocator<BSTree<int, NodePool>>(
+    "Binary Search Tree (node pool)", keys);
+  measureAllocator<RBTree<int, NewDeleteAllocator>>(
+    "Red-Black Tree (new/delete)", keys);
+  measureAllocator<RBTree<int, NodePool>>(
+    "Red-Black Tree (node pool)", keys);
+  std::cout << "\n";
+}
+
+/**
+ * Function to compare rebuilding a structure by inserting its keys one by
+ * one with saving it to a snapshot file and loading it into another one.
+ */
+template <typename Structure>
+void measureSnapshot(Structure& inserted, Structure& loaded,
+  const std::vector<int>& keys) {
+  const char* path = "snapshot.bin";
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int key : keys) {
+    inserted.insert(key);
+  }
+  auto middle = std::chrono::high_resolution_clock::now();
+  bool saved = inserted.saveSnapshot(path);
+  auto loading = std::chrono::high_resolution_clock::now();
+  bool ok = saved && loaded.loadSnapshot(path);
+  auto end = std::chrono::high_resolution_clock::now();
+  std::remove(path);
+  std::chrono::duration<double, std::milli> insertion = middle - start;
+  std::chrono::duration<double, std::milli> save = loading - middle;
+  std::chrono::duration<double, std::milli> load = end - loading;
+  std::cout << structureName<Structure>() << ": insertion "
+    << insertion.count() << " ms, saveSnapshot() " << save.count()
+    << " ms, loadSnapshot() " << load.count() << " ms"
+    << (ok ? "" : " (failed)") << "\n";
+}
+
+/**
+ * Function to compare the startup of the red-black tree and the hash table
+ * from a snapshot file with rebuilding them from their keys.
+ */
+void compareSnapshots(int n, std::mt19937& rng) {
+  std::cout << "----- Snapshots -----\n\n";
+  std::uniform_int_distribution<int> dist(0, 3 * n - 1);
+  std::vector<int> keys(n);
+  for (int& key : keys) key = dist(rng);
+  RBTree<int> rbtInserted;
+  RBTree<int> rbtLoaded;
+  measureSnapshot(rbtInserted, rbtLoaded, keys);
+  ChainedHashTable<int> htInserted(16);
+  ChainedHashTable<int> htLoaded(16);
+  measureSnapshot(htInserted, htLoaded, keys);
+  std::cout << "\n";
+}
+
+/**
+ * Function to compare storing records of 16 ints in a red-black tree map by
+ * copying each record into the tree with insert() and by moving it with
+ * try_emplace().
+ */
+void compareRecordInsertion(int n, std::mt19937& rng) {
+  std::cout << "----- Key/value maps -----\n\n";
+  std::uniform_int_distribution<int> dist(0, 3 * n - 1);
+  std::vector<int> keys(n);
+  for (int& key : keys) key = dist(rng);
+  using Record = std::vector<int>;
+  RBTreeMap<int, Record> copied;
+  RBTreeMap<int, Record> moved;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int key : keys) {
+    Record record(16, key);
+    copied.insert(KeyValuePair<int, Record>(key, record));
+  }
+  auto middle = std::chrono::high_resolution_clock::now();
+  for (int key : keys) {
+    Record record(16, key);
+    moved.try_emplace(key, std::move(record));
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> copying = middle - start;
+  std::chrono::duration<double, std::milli> moving = end - middle;
+  std::cout << "Insertion of records in Red-Black Tree map, insert() with "
+    << "a copy / try_emplace() with a move: " << copying.count() << " ms / "
+    << moving.count() << " ms\n\n";
+}
+
+/**
+ * Function to time e searches of inserted keys drawn uniformly and the same
+ * number drawn from a Zipf distribution, where a few hot keys take most of
+ * the searches.
+ */
+template <typename Structure>
+void measureSkewedSearch(Structure& structure, const std::vector<int>& keys,
+  const std::vector<int>& uniform, const std::vector<int>& zipf) {
+  for (int key : keys) {
+    structure.insert(key);
+  }
+  std::chrono::duration<double, std::milli> elapsed[2];
+  const std::vector<int>* queries[2] = {&uniform, &zipf};
+  size_t found = 0;
+  for (int i = 0; i < 2; ++i) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int value : *queries[i]) {
+      if constexpr (std::is_same_v<Structure, RBTree<int>>) {
+        /** The red-black tree returns its sentinel for a missing key. */
+        found += structure.search(structure.getRoot(), value) !=
+          structure.getNil();
+      } else if constexpr (std::is_same_v<Structure, BSTree<int>>) {
+        found += structure.search(structure.getRoot(), value) != nullptr;
+      } else {
+        found += structure.search(value) != nullptr;
+      }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    elapsed[i] = end - start;
+  }
+  std::cout << "Search time (uniform / Zipf) in " << structureName<Structure>()
+    << ": " << elapsed[0].count() << " ms / " << elapsed[1].count() << " ms"
+    << (found == uniform.size() + zipf.size() ? "" : " (keys missing)")
+    << "\n";
+}
+
+/**
+ * Function to compare the structures under a skewed workload: e searches of
+ * inserted keys that follow a Zipf distribution, where the key of rank r is
+ * searched with probability proportional to 1 / r^exponent. The ranks are
+ * given to the keys at random, so the hot keys do not depend on the order in
+ * which they were inserted.
+ */
+void compareZipf(int n, int e, double exponent, std::mt19937& rng) {
+  std::cout << "----- Skewed (Zipf) searches, exponent " << exponent
+    << " -----\n\n";
+  std::uniform_int_distribution<int> dist(0, 3 * n - 1);
+  std::vector<int> keys(n);
+  for (int& key : keys) key = dist(rng);
+  /** Key of each rank. */
+  std::vector<int> ranked(keys);
+  std::shuffle(ranked.begin(), ranked.end(), rng);
+  /** Cumulative weights of the ranks. */
+  std::vector<double> cdf(n);
+  double total = 0;
+  for (int r = 0; r < n; ++r) {
+    total += 1.0 / std::pow(r + 1, exponent);
+    cdf[r] = total;
+  }
+  std::uniform_real_distribution<double> weight(0, total);
+  std::uniform_int_distribution<int> rank(0, n - 1);
+  std::vector<int> uniform(e);
+  std::vector<int> zipf(e);
+  for (int i = 0; i < e; ++i) {
+    uniform[i] = ranked[rank(rng)];
+    auto r = std::upper_bound(cdf.begin(), cdf.end(), weight(rng));
+    zipf[i] = ranked[std::min<size_t>(r - cdf.begin(), n - 1)];
+  }
+  SLList<int> sll;
+  measureSkewedSearch(sll, keys, uniform, zipf);
+  UnrolledLinkedList<int> ull;
+  measureSkewedSearch(ull, keys, uniform, zipf);
+  BSTree<int> bst;
+  measureSkewedSearch(bst, keys, uniform, zipf);
+  RBTree<int> rbt;
+  measureSkewedSearch(rbt, keys, uniform, zipf);
+  SplayTree<int> spt;
+  measureSkewedSearch(spt, keys, uniform, zipf);
+  BPlusTree<int> bpt;
+  measureSkewedSearch(bpt, keys, uniform, zipf);
+  ChainedHashTable<int> ht(n);
+  measureSkewedSearch(ht, keys, uniform, zipf);
+  FlatHashTable<int> fht(n);
+  measureSkewedSearch(fht, keys, uniform, zipf);
+  std::cout << "\n";
+}
+
 int main() {
   /** Nodes to insert. */
   constexpr int n = 1'000'000;
@@ -160,6 +810,32 @@ int main() {
   /** 5.1.2. Ordered deletion. */
   measureDeletion(sllO, e, rng, dist, true);
 
+  /** ----- Unrolled Linked List ----- */
+
+  /** Create an Unrolled Linked List with 32 keys per node. */
+  UnrolledLinkedList<int> ullR;  /** Random list. */
+
+  /** Random insertion. */
+  measureInsertion(ullR, n, rng, dist, false);
+
+  /** Random search. */
+  measureSearch(ullR, e, rng, dist, false);
+
+  /** Random deletion. */
+  measureDeletion(ullR, e, rng, dist, false);
+
+  /** Create an Unrolled Linked List with 32 keys per node. */
+  UnrolledLinkedList<int> ullO;  /** Ordered list. */
+
+  /** Ordered insertion. */
+  measureInsertion(ullO, n, rng, dist, true);
+
+  /** Ordered search. */
+  measureSearch(ullO, e, rng, dist, true);
+
+  /** Ordered deletion. */
+  measureDeletion(ullO, e, rng, dist, true);
+
   /** ----- Binary Search Tree ----- */
 
   /** Create a Binary Search Tree. */
@@ -170,6 +846,7 @@ int main() {
 
   /** 5.1.1. Random search. */
   measureSearch(bstR, e, rng, dist, false);
+  measureSearchBatch(bstR, e, rng, dist);
 
   /** 5.1.1. Random deletion. */
   measureDeletion(bstR, e, rng, dist, false);
@@ -196,6 +873,8 @@ int main() {
 
   /** 5.1.2. Ordered search. */
   measureSearch(rbtR, e, rng, dist, false);
+  measureSearchBatch(rbtR, e, rng, dist);
+  measureFrozenSearch(rbtR, e, rng, dist);
 
   /** 5.1.2. Ordered deletion. */
   measureDeletion(rbtR, e, rng, dist, false);
@@ -212,6 +891,61 @@ int main() {
   /** 5.1.2. Ordered deletion. */
   measureDeletion(rbtO, e, rng, dist, true);
 
+  /** Range query over the ordered keys. */
+  measureRangeScan(rbtO, e, n / 2);
+
+  /** ----- Splay Tree ----- */
+
+  /** Create a Splay Tree. */
+  SplayTree<int> sptR;  /** Random tree. */
+
+  /** Random insertion. */
+  measureInsertion(sptR, n, rng, dist, false);
+
+  /** Random search. */
+  measureSearch(sptR, e, rng, dist, false);
+
+  /** Random deletion. */
+  measureDeletion(sptR, e, rng, dist, false);
+
+  /** Create a Splay Tree. */
+  SplayTree<int> sptO;  /** Ordered tree. */
+
+  /** Ordered insertion. */
+  measureInsertion(sptO, n, rng, dist, true);
+
+  /** Ordered search. */
+  measureSearch(sptO, e, rng, dist, true);
+
+  /** Ordered deletion. */
+  measureDeletion(sptO, e, rng, dist, true);
+
+  /** ----- B+ Tree ----- */
+
+  /** Create a B+ Tree with 64 keys per node. */
+  BPlusTree<int> bptR;  /** Random tree. */
+
+  /** Random insertion. */
+  measureInsertion(bptR, n, rng, dist, false);
+
+  /** Random search. */
+  measureSearch(bptR, e, rng, dist, false);
+
+  /** Random deletion. */
+  measureDeletion(bptR, e, rng, dist, false);
+
+  /** Create a B+ Tree with 64 keys per node. */
+  BPlusTree<int> bptO;  /** Ordered tree. */
+
+  /** Ordered insertion. */
+  measureInsertion(bptO, n, rng, dist, true);
+
+  /** Ordered search. */
+  measureSearch(bptO, e, rng, dist, true);
+
+  /** Ordered deletion. */
+  measureDeletion(bptO, e, rng, dist, true);
+
   /** ----- Hash Table ----- */
 
   /** Create a Hash Table. */
@@ -222,6 +956,8 @@ int main() {
 
   /** 5.1.2. Ordered search. */
   measureSearch(htR, e, rng, dist, false);
+  measureSearchBatch(htR, e, rng, dist);
+  measureTableScan(htR);
 
   /** 5.1.2. Ordered deletion. */
   measureDeletion(htR, e, rng, dist, false);
@@ -238,5 +974,65 @@ int main() {
   /** 5.1.2. Ordered deletion. */
   measureDeletion(htO, e, rng, dist, true);
 
+  /**
+   * Hash tables that start with few buckets and grow with the keys. The
+   * chained table rehashes incrementally, the flat table all at once.
+   */
+  ChainedHashTable<int> htG(16);  /** Growing table. */
+  measureInsertionLatency(htG, n, rng, dist);
+
+  /** ----- Flat Hash Table ----- */
+
+  /** Create a Flat Hash Table with room for n keys. */
+  FlatHashTable<int> fhtR(n);  /** Random table. */
+
+  /** Random insertion. */
+  measureInsertion(fhtR, n, rng, dist, false);
+
+  /** Random search. */
+  measureSearch(fhtR, e, rng, dist, false);
+
+  /** Random deletion. */
+  measureDeletion(fhtR, e, rng, dist, false);
+
+  /** Create a Flat Hash Table with room for n keys. */
+  FlatHashTable<int> fhtO(n);  /** Ordered table. */
+
+  /** Ordered insertion. */
+  measureInsertion(fhtO, n, rng, dist, true);
+
+  /** Ordered search. */
+  measureSearch(fhtO, e, rng, dist, true);
+
+  /** Ordered deletion. */
+  measureDeletion(fhtO, e, rng, dist, true);
+
+  FlatHashTable<int> fhtG(16);  /** Growing table. */
+  measureInsertionLatency(fhtG, n, rng, dist);
+
+  /** ----- Hasher policies ----- */
+  compareHashers(n, e, rng);
+
+  /** ----- Concurrent Hash Table ----- */
+  measureConcurrency(10 * n, n);
+
+  /** ----- Concurrent Skip List ----- */
+  measureOrderedConcurrency(10 * n, n);
+
+  /** ----- Node allocators ----- */
+  compareAllocators(n, rng);
+
+  /** ----- Order statistics ----- */
+  measureOrderStatistics(n, e, rng);
+
+  /** ----- Snapshots ----- */
+  compareSnapshots(n, rng);
+
+  /** ----- Key/value maps ----- */
+  compareRecordInsertion(n, rng);
+
+  /** ----- Skewed (Zipf) searches ----- */
+  compareZipf(n, e, 1.0, rng);
+
   return 0;
 }